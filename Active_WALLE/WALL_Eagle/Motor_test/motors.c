@@ -2,6 +2,7 @@
 #include <BOARD.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include <AD.h>
 #include <RC_Servo.h>
 #include <LED.h>
@@ -9,6 +10,7 @@
 #include <IO_Ports.h>
 #include "PinsMaster.h"
 #include "BatteryAdjust.h"
+#include "motors.h"
 
 //#define LEFT_PWM_PIN PWM_PORTY10
 //#define LEFT_DIR_PIN PORTY,PIN9
@@ -17,6 +19,24 @@
 
 #define PWM_FREQUENCY 1000
 
+// wheel duties as last written, after the trim and AdjustPWM(), signed,
+// forward positive
+static int left_duty;
+static int right_duty;
+
+// per wheel calibration, duty = deadband + speed * scale, see SetMotorCalibration()
+typedef struct {
+    int deadband;
+    int scale;      // gain * (MOTOR_MAX_SPEED - deadband) / MOTOR_MAX_SPEED, Q15
+} WheelTrim_t;
+
+static WheelTrim_t left_trim = {0, MOTOR_GAIN_ONE};
+static WheelTrim_t right_trim = {0, MOTOR_GAIN_ONE};
+
+static int Trimmed(const WheelTrim_t *trim, int speed);
+static int Duty(const WheelTrim_t *trim, int speed);
+static void SetTrim(WheelTrim_t *trim, int gain, int deadband);
+
 void InitMotors(void){
     PWM_Init();
     PWM_AddPins(RIGHT_PWM_PIN);
@@ -27,137 +47,98 @@ void InitMotors(void){
 }
 
 void RightMotorMoveForward(int speed){
-    speed = AdjustPWM(speed);
+    speed = Duty(&right_trim, speed);
+    right_duty = speed;
     PWM_SetDutyCycle(RIGHT_PWM_PIN, speed);
     IO_PortsClearPortBits(RIGHT_DIR_PIN);
 }
 
 void RightMotorMoveBackward(int speed){
-    speed = AdjustPWM(speed);
+    speed = Duty(&right_trim, speed);
+    right_duty = -speed;
     PWM_SetDutyCycle(RIGHT_PWM_PIN, speed);
     IO_PortsSetPortBits(RIGHT_DIR_PIN);
 }
 
 void RightMotorHalt(void){
+    right_duty = 0;
     PWM_SetDutyCycle(RIGHT_PWM_PIN, 0);
     IO_PortsClearPortBits(RIGHT_DIR_PIN);
 }
 
 void LeftMotorMoveForward(int speed){
-    speed = AdjustPWM(speed);
+    speed = Duty(&left_trim, speed);
+    left_duty = speed;
     PWM_SetDutyCycle(LEFT_PWM_PIN, speed);
     IO_PortsSetPortBits(LEFT_DIR_PIN);
 }
 
 void LeftMotorMoveBackward(int speed){
-    speed = AdjustPWM(speed);
+    speed = Duty(&left_trim, speed);
+    left_duty = -speed;
     PWM_SetDutyCycle(LEFT_PWM_PIN, speed);
     IO_PortsClearPortBits(LEFT_DIR_PIN);
 }
 
 void LeftMotorHalt(void){
+    left_duty = 0;
     PWM_SetDutyCycle(LEFT_PWM_PIN, 0);
     IO_PortsClearPortBits(LEFT_DIR_PIN);
 }
 
-void BotHalt(void){
-    LeftMotorHalt();
-    RightMotorHalt();
-}
-
-void BotMoveForward(int speed){
-    speed = AdjustPWM(speed);
-    RightMotorMoveForward(speed);
-    LeftMotorMoveForward(speed);
-}
-
-void BotMoveBackward(int speed){
-    speed = AdjustPWM(speed);
-    RightMotorMoveBackward(speed);
-    LeftMotorMoveBackward(speed);
-}
-
-void BotTankTurnRight(int speed){
-    speed = AdjustPWM(speed);
-    RightMotorMoveBackward(speed);
-    LeftMotorMoveForward(speed);
-}
-
-void BotTankTurnLeft(int speed){
-    speed = AdjustPWM(speed);
-    LeftMotorMoveBackward(speed);
-    RightMotorMoveForward(speed);
-}
-
-void BotRPivotRight(int speed){
-    speed = AdjustPWM(speed);
-    int short_speed = speed/2;
-    LeftMotorMoveForward(short_speed);
-    RightMotorMoveBackward(speed);
-}
-
-void BotRPivotLeft(int speed){
-    speed = AdjustPWM(speed);
-    int short_speed = speed/2;
-    RightMotorMoveForward(short_speed);
-    LeftMotorMoveBackward(speed);
-}
-
-void BotRRPivotRight(int speed){
-    speed = AdjustPWM(speed);
-    int short_speed = speed/3;
-    LeftMotorMoveBackward(short_speed);
-    RightMotorMoveBackward(speed);
-}
-
-void BotRRPivotLeft(int speed){
-    speed = AdjustPWM(speed);
-    int short_speed = speed/3;
-    RightMotorMoveBackward(short_speed);
-    LeftMotorMoveBackward(speed);
-}
-
-void BotBankTurnLeft(int speed, int factor){
-    speed = AdjustPWM(speed);
-    int short_speed = speed / factor;
-    LeftMotorMoveForward(short_speed);
-    RightMotorMoveForward(speed);
-}
-
-void BotRBankTurnLeft(int speed, int factor){
-    speed = AdjustPWM(speed);
-    int short_speed = speed / factor;
-    LeftMotorMoveBackward(short_speed);
-    RightMotorMoveBackward(speed);
-}
-
-void BotBankTurnRight(int speed, int factor){
-    speed = AdjustPWM(speed);
-    int short_speed = speed / factor;
-    RightMotorMoveForward(short_speed);
-    LeftMotorMoveForward(speed);
-}
-
-void BotRBankTurnRight(int speed, int factor){
-    speed = AdjustPWM(speed);
-    int short_speed = speed / factor;
-    RightMotorMoveBackward(short_speed);
-    LeftMotorMoveBackward(speed);
-}
-
-void BotTrueRPivotLeft(int speed){
-    speed = AdjustPWM(speed);
-    RightMotorHalt();
-    LeftMotorMoveBackward(speed);
-}
-
-void BotTrueRPivotRight(int speed){
-    speed = AdjustPWM(speed);
-    LeftMotorHalt();
-    RightMotorMoveBackward(speed);
-}
-
-void BotInOrbit(){
-    LeftMotorMoveForward(AdjustPWM(540));
-    RightMotorMoveForward(AdjustPWM(210));
+void SetMotorCalibration(int left_gain, int left_deadband, int right_gain, int right_deadband){
+    SetTrim(&left_trim, left_gain, left_deadband);
+    SetTrim(&right_trim, right_gain, right_deadband);
+}
+
+// Differential drive: the wheels run at v - w (left) and v + w (right). If
+// one of them would go past MOTOR_MAX_SPEED both are scaled down by the same
+// Q15 factor, so the curve keeps its radius and only gets slower. A wheel is
+// only written when its duty changed. The duty is worked out through the trim
+// and AdjustPWM() on every call, so a repeated command still follows the
+// battery and a new trim, and only the PWM and pin writes are saved.
+void BotDrive(int v, int w){
+    int left = v - w;
+    int right = v + w;
+    int peak = abs(left) > abs(right) ? abs(left) : abs(right);
+    int32_t scale;
+    int duty;
+
+    if (peak > MOTOR_MAX_SPEED) {
+        // rounded up, so the faster wheel lands on MOTOR_MAX_SPEED, not one under
+        scale = (((int32_t) MOTOR_MAX_SPEED << 15) + peak - 1) / peak;
+        left = left * scale / (1 << 15);
+        right = right * scale / (1 << 15);
+    }
+    duty = left < 0 ? -Duty(&left_trim, -left) : Duty(&left_trim, left);
+    if (duty != left_duty) {
+        if (left > 0) LeftMotorMoveForward(left);
+        else if (left < 0) LeftMotorMoveBackward(-left);
+        else LeftMotorHalt();
+    }
+    duty = right < 0 ? -Duty(&right_trim, -right) : Duty(&right_trim, right);
+    if (duty != right_duty) {
+        if (right > 0) RightMotorMoveForward(right);
+        else if (right < 0) RightMotorMoveBackward(-right);
+        else RightMotorHalt();
+    }
+}
+
+// Lifts a wheel command over the static friction deadband and scales the rest
+// of the range, so speed 1 just starts the wheel and MOTOR_MAX_SPEED is the
+// gain's share of full duty.
+static int Trimmed(const WheelTrim_t *trim, int speed){
+    if (speed <= 0) return 0;
+    speed = trim->deadband + (int) (((int32_t) speed * trim->scale) >> 15);
+    return speed > MOTOR_MAX_SPEED ? MOTOR_MAX_SPEED : speed;
+}
+
+// what the wheel functions write for a speed, AdjustPWM() once per wheel
+static int Duty(const WheelTrim_t *trim, int speed){
+    return AdjustPWM(Trimmed(trim, speed));
+}
+
+static void SetTrim(WheelTrim_t *trim, int gain, int deadband){
+    trim->deadband = deadband;
+    trim->scale = (int32_t) gain * (MOTOR_MAX_SPEED - deadband) / MOTOR_MAX_SPEED;
 }
@@ -3,6 +3,24 @@
  * Author: hkuttive
  *
  * Created on November 9, 2016, 4:57 PM
+ *
+ * All driving goes through BotDrive(v, w): v is the body speed and w the turn
+ * rate, both in the 0-1000 PWM speed units the wheels take. w is what each
+ * wheel adds (right) or gives up (left) on top of v, so positive w turns left
+ * and v = 0 spins in place. The Bot* moves below are fixed (v, w) pairs kept
+ * for the state machines; a controller can instead send a fresh (v, w) every
+ * sensor frame and change curvature smoothly.
+ *
+ * Each wheel command goes through that wheel's calibration (gain and static
+ * friction deadband, SetMotorCalibration()) on its way to the PWM, so equal
+ * commands give equal wheel speeds once WheelCalService has run. The battery
+ * compensation, AdjustPWM() (a pass-through unless USE_BAT_ADJUSTED_SPEED),
+ * then scales the duty by k = 9.7 V over the battery voltage, once. The Bot*
+ * functions before BotDrive() applied it twice, speed * k * k, so their
+ * hand-tuned speeds only keep their duty with the compensation off.
+ *
+ * Motor_test/motors.h and WALL_Eagle.X/motors.h are the same file, each
+ * project finds its own copy first. Keep them equal.
  */
 
 
@@ -13,6 +31,8 @@
 extern "C" {
 #endif
 
+#define MOTOR_MAX_SPEED 1000    // full duty, MAX_PWM in pwm.h
+#define MOTOR_GAIN_ONE 32768    // unity wheel gain, Q15
 
     void InitMotors(void);
     void RightMotorMoveForward(int speed);
@@ -21,25 +41,84 @@ extern "C" {
     void LeftMotorMoveForward(int speed);
     void LeftMotorMoveBackward(int speed);
     void LeftMotorHalt(void);
-    void BotMoveForward(int speed);
-    void BotMoveBackward(int speed);
-    void BotTankTurnRight(int speed);
-    void BotTankTurnLeft(int speed);
-    void BotRPivotRight(int speed);
-    void BotRPivotLeft(int speed);
-    void BotRRPivotRight(int speed);
-    void BotRRPivotLeft(int speed);
-    void BotBankTurnLeft(int speed, int factor);
-    void BotRBankTurnLeft(int speed, int factor);
-    void BotBankTurnRight(int speed, int factor);
-    void BotRBankTurnRight(int speed, int factor);
-    void BotTrueRPivotLeft(int speed);
-    void BotTrueRPivotRight(int speed);
-    void BotInOrbit();
+    void BotDrive(int v, int w);
+    void SetMotorCalibration(int left_gain, int left_deadband, int right_gain, int right_deadband);
+
+    static inline void BotHalt(void) {
+        BotDrive(0, 0);
+    }
+
+    static inline void BotMoveForward(int speed) {
+        BotDrive(speed, 0);
+    }
+
+    static inline void BotMoveBackward(int speed) {
+        BotDrive(-speed, 0);
+    }
+
+    static inline void BotTankTurnRight(int speed) {
+        BotDrive(0, -speed);
+    }
+
+    static inline void BotTankTurnLeft(int speed) {
+        BotDrive(0, speed);
+    }
+
+    // left forward at half speed, right backward at full
+    static inline void BotRPivotRight(int speed) {
+        BotDrive(-speed / 4, -3 * speed / 4);
+    }
+
+    static inline void BotRPivotLeft(int speed) {
+        BotDrive(-speed / 4, 3 * speed / 4);
+    }
+
+    // both backward, the left wheel at a third
+    static inline void BotRRPivotRight(int speed) {
+        BotDrive(-2 * speed / 3, -speed / 3);
+    }
+
+    static inline void BotRRPivotLeft(int speed) {
+        BotDrive(-2 * speed / 3, speed / 3);
+    }
+
+    // outer wheel at speed, inner wheel at speed / factor
+    static inline void BotBankTurnLeft(int speed, int factor) {
+        int inner = speed / factor;
+        BotDrive((speed + inner) / 2, (speed - inner) / 2);
+    }
+
+    static inline void BotRBankTurnLeft(int speed, int factor) {
+        int inner = speed / factor;
+        BotDrive(-(speed + inner) / 2, -(speed - inner) / 2);
+    }
+
+    static inline void BotBankTurnRight(int speed, int factor) {
+        int inner = speed / factor;
+        BotDrive((speed + inner) / 2, -(speed - inner) / 2);
+    }
+
+    static inline void BotRBankTurnRight(int speed, int factor) {
+        int inner = speed / factor;
+        BotDrive(-(speed + inner) / 2, (speed - inner) / 2);
+    }
+
+    // one wheel stopped, the other backward
+    static inline void BotTrueRPivotLeft(int speed) {
+        BotDrive(-speed / 2, speed / 2);
+    }
+
+    static inline void BotTrueRPivotRight(int speed) {
+        BotDrive(-speed / 2, -speed / 2);
+    }
+
+    // left 540, right 210
+    static inline void BotInOrbit(void) {
+        BotDrive(375, -165);
+    }
 
 #ifdef	__cplusplus
 }
 #endif
 
 #endif	/* MOTORS_H */
-
@@ -0,0 +1,143 @@
+/*
+ * File:   ADFrame.c
+ *
+ * Ring of AD scans with per reader sequence tracking, see ADFrame.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "AD.h"
+#include "ADFrame.h"
+#include "HIL.h"
+#include "SensorTier.h"
+#include <stddef.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define SlotOf(seq) ((seq) & (AD_FRAME_DEPTH - 1))
+#define Barrier() __asm__ __volatile__("" ::: "memory")  // frame before seq
+
+#ifdef HIL_MODE
+// readings come from the host and every frame is answered, see HIL.h
+#define NewDataReady() HIL_Receive(hil_values)
+#define ReadChannel(pin, channel) hil_values[channel]
+#define Published() HIL_Reply()
+#else
+#define NewDataReady() AD_IsNewDataReady()
+#define ReadChannel(pin, channel) AD_ReadADPin(pin)
+#define Published()
+#endif
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static uint8_t ChannelOf(uint32_t pin);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static ADFrame_t frames[AD_FRAME_DEPTH];
+static volatile uint32_t newest = 0;   // written by ADFrame_Capture()
+static uint32_t notified = 0;          // newest the subscribers were told about
+static uint8_t(*subscribers[AD_FRAME_MAX_SUBSCRIBERS])(ES_Event);
+static uint8_t num_subscribers = 0;
+#ifdef HIL_MODE
+static uint16_t hil_values[AD_FRAME_CHANNELS];
+#endif
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t ADFrame_Subscribe(uint8_t(*PostFunction)(ES_Event)) {
+    if (num_subscribers == AD_FRAME_MAX_SUBSCRIBERS) return FALSE;
+    subscribers[num_subscribers++] = PostFunction;
+    return TRUE;
+}
+
+void ADFrame_Capture(void) {
+    ADFrame_t *frame, *previous;
+    uint32_t pins, pin, active;
+    uint8_t channel;
+
+    if (!NewDataReady()) return;
+
+    frame = &frames[SlotOf(newest + 1)];
+    previous = &frames[SlotOf(newest)];
+    active = AD_ActivePins();
+    for (pins = AD_PIN_LIST, channel = 0; pins; pins &= ~pin, channel++) {
+        pin = pins & -pins;
+        // channels switched off by SensorRate keep their last reading
+        frame->value[channel] = (active & pin) ? ReadChannel(pin, channel) : previous->value[channel];
+    }
+    frame->timestamp = ES_Timer_GetTime();
+    frame->stamp = SensorTier_Stamp();
+    frame->seq = newest + 1;
+    Barrier();
+    newest = frame->seq;
+    Published();
+    SensorTier_Pend(TIER_TAPE);
+}
+
+uint8_t ADFrame_Publish(void) {
+    ES_Event ThisEvent;
+    uint32_t seq;
+    uint8_t i;
+
+#ifdef HIL_MODE
+    SensorTier_Pend(TIER_ACQUIRE);
+#endif
+    seq = newest;
+    if (seq == notified) return FALSE;
+    notified = seq;
+
+    ThisEvent.EventType = AD_FRAME_READY;
+    ThisEvent.EventParam = (uint16_t) seq;
+    for (i = 0; i < num_subscribers; i++) {
+        subscribers[i](ThisEvent);
+    }
+    return TRUE;
+}
+
+const ADFrame_t *ADFrame_Next(ADFrame_Reader_t *reader) {
+    uint32_t seq = newest;  // once, the acquire actor can move it
+    uint32_t skipped;
+
+    if (seq == reader->seq) return NULL;
+    if (reader->seq != 0) {
+        skipped = seq - reader->seq - 1;
+        reader->missed = (skipped > UINT16_MAX - reader->missed) ?
+                UINT16_MAX : reader->missed + skipped;
+    }
+    reader->seq = seq;
+    return &frames[SlotOf(seq)];
+}
+
+uint16_t ADFrame_Read(const ADFrame_t *frame, uint32_t pin) {
+    return frame->value[ChannelOf(pin)];
+}
+
+uint32_t ADFrame_Sequence(void) {
+    return newest;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// a pin's channel is the number of AD_PIN_LIST pins below it
+static uint8_t ChannelOf(uint32_t pin) {
+    uint32_t below = AD_PIN_LIST & (pin - 1);
+    uint8_t channel = 0;
+    while (below) {
+        below &= below - 1;
+        channel++;
+    }
+    return channel;
+}
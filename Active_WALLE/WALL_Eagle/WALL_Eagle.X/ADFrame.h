@@ -0,0 +1,108 @@
+/*
+ * File:   ADFrame.h
+ *
+ * Sequence numbered frames of every pin in AD_PIN_LIST, shared by all the
+ * sensor services.
+ *
+ * AD_IsNewDataReady() clears the library's flag on read, so with several
+ * services polling it only one of them saw each scan and the others skipped
+ * a sample until their next timer. Now ADFrame_Capture() is the only caller.
+ * It runs as the TIER_ACQUIRE actor (SensorTier.h) on every tier tick, copies
+ * a finished scan into a small ring, stamps it and pends the tape actor.
+ * ADFrame_Publish() is the event checker that then posts AD_FRAME_READY to
+ * every subscriber in the loop, once per pass however many frames came in.
+ *
+ * Pins taken out of the scan (SensorRate.h) keep their last reading. In
+ * HIL_MODE the frames come from the host instead of the AD converter (HIL.h)
+ * and ADFrame_Publish() pends the capture itself.
+ *
+ * Each consumer keeps an ADFrame_Reader_t and pulls with ADFrame_Next(), which
+ * hands out the newest frame it has not seen yet. Readers never block each
+ * other and frames a slow reader missed are counted per reader. A frame is
+ * only overwritten AD_FRAME_DEPTH tier ticks after it was captured, which is
+ * the time a loop reader has to finish with it.
+ *
+ * The AD library is part of the class framework, so its scan-complete
+ * interrupt cannot capture frames directly. Polling from the tier tick keeps
+ * the capture within SENSOR_TIER_PERIOD of the scan, whatever the loop does.
+ */
+
+#ifndef ADFRAME_H
+#define	ADFRAME_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+#include "PinsMaster.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define AD_FRAME_CHANNELS 9         // pins in AD_PIN_LIST
+#define AD_FRAME_DEPTH 8            // frames kept, a power of two
+#define AD_FRAME_MAX_SUBSCRIBERS 4
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef struct {
+    uint32_t seq;                   // 1 for the first frame, never 0
+    uint32_t timestamp;             // ES_Timer_GetTime() at capture
+    uint32_t stamp;                 // core timer at the tier tick that captured it
+    uint16_t value[AD_FRAME_CHANNELS]; // in AD_PIN_LIST bit order
+} ADFrame_t;
+
+typedef struct {
+    uint32_t seq;                   // last frame handed out, 0 for none
+    uint16_t missed;                // frames published but never handed out
+} ADFrame_Reader_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ADFrame_Subscribe(uint8_t (*PostFunction)(ES_Event))
+ * @param PostFunction - gets AD_FRAME_READY, param is the low 16 bits of seq
+ * @return TRUE, or FALSE if AD_FRAME_MAX_SUBSCRIBERS are taken */
+uint8_t ADFrame_Subscribe(uint8_t(*PostFunction)(ES_Event));
+
+/**
+ * @Function ADFrame_Capture(void)
+ * @return None
+ * @brief The TIER_ACQUIRE actor. Takes the frame if the AD library finished a
+ *        scan and pends TIER_TAPE. */
+void ADFrame_Capture(void);
+
+/**
+ * @Function ADFrame_Publish(void)
+ * @return TRUE if the subscribers were notified
+ * @brief The event checker. Posts AD_FRAME_READY if a frame was captured since
+ *        the last call. */
+uint8_t ADFrame_Publish(void);
+
+/**
+ * @Function ADFrame_Next(ADFrame_Reader_t *reader)
+ * @param reader - the consumer's read position
+ * @return the newest frame newer than the reader's last one, or NULL */
+const ADFrame_t *ADFrame_Next(ADFrame_Reader_t *reader);
+
+/**
+ * @Function ADFrame_Read(const ADFrame_t *frame, uint32_t pin)
+ * @param pin - one AD_PORTxx pin from AD_PIN_LIST
+ * @return the pin's reading in frame, like AD_ReadADPin() */
+uint16_t ADFrame_Read(const ADFrame_t *frame, uint32_t pin);
+
+/**
+ * @Function ADFrame_Sequence(void)
+ * @return seq of the newest frame, 0 before the first */
+uint32_t ADFrame_Sequence(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* ADFRAME_H */
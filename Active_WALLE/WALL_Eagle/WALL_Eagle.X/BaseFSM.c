@@ -37,6 +37,7 @@
 //#include "roach.h"
 //#include "RoachFrameworkEvents.h"
 #include <stdio.h>
+#include "SerialTx.h"
 #include <motors.h>
 
 
@@ -68,7 +69,7 @@ typedef enum {
     LeftRealign,
 } TemplateFSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPState",
 	"MoveForward",
 	"FoundRightTape",
@@ -134,7 +135,7 @@ uint8_t PostBaseFSM(ES_Event ThisEvent) {
  *       Returns ES_NO_EVENT if the event have been "consumed."
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 ES_Event RunBaseFSM(ES_Event ThisEvent) {
-    printf("\r\nEvent: %s\tParam: 0x%04X",
+    SerialTx_Printf("\r\nEvent: %s\tParam: 0x%04X",
             EventNames[ThisEvent.EventType], ThisEvent.EventParam);
     uint8_t makeTransition = FALSE; // use to flag transition
     TemplateFSMState_t nextState; // <- need to change enum type here
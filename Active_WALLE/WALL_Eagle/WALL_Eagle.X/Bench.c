@@ -0,0 +1,672 @@
+/*
+ * File:   Bench.c
+ *
+ * Host micro-benchmarks for the hot paths. This is not part of the MPLAB
+ * project: Bench.py builds it with the host gcc together with the modules it
+ * measures, runs it and compares runs. The state machines and services are
+ * linked as they are, against the stand-ins for the framework and the
+ * CMPE118 drivers in bench/.
+ *
+ * Every benchmark runs its body until at least BENCH_MIN_NS has passed and
+ * prints one line, between a begin and an end marker:
+ *
+ *   #BENCH begin <channels>
+ *   B <name> <iterations> <ns/op> <allocations/op>
+ *   #BENCH end
+ *
+ * Allocations are counted by wrapping malloc, calloc and realloc at link time
+ * (-Wl,--wrap=...), the hot paths are required to stay at 0.
+ *
+ * The tape_sensors benchmarks run the same three workloads as the
+ * tape_frame_process ones on the layout TapeSensorService used before
+ * TapeFrame: one struct per sensor, diff, classification, drift and packing
+ * done sensor by sensor. Run with -n 4,6,8 to compare the two per channel.
+ *
+ * adjust_pwm is BatteryAdjust's AdjustPWM(), a pass-through unless
+ * USE_BAT_ADJUSTED_SPEED is defined. tape_archive_mean and tape_moving_mean
+ * are TapeSensorService's FindArchiveMean() on a full archive and
+ * FindMovingMean() archiving a new status every call.
+ *
+ * The top_hsm_dispatch benchmarks hand RunTopHSM() an event no state handles
+ * and an ES_NO_EVENT, with the machine in InitializationState as it is after
+ * boot. They and adjust_pwm have the same names as the CycleBench.c kernels,
+ * so "Bench.py -t" lines the two up. The top_hsm_reload and top_hsm_score
+ * benchmarks first walk the machines through the boot sequence (and a
+ * BALLS_LOADED) into TapeFollowingState and ZoneInState, then dispatch one
+ * event per iteration from a cycle that ends where it started:
+ *
+ *   reload_tape     TAPE_SENSOR_TRIPPED, handled in TapeFollowSM's MoveForward
+ *   reload_timeout  ES_TIMEOUT, MoveForward and ShiftDirection in turn
+ *   reload_bump     BUMPER_TRIPPED, ES_TIMEOUT x2 through BumpResState and back
+ *   reload_beacon   BEACON_FOUND into RadarState, BEACON_LOST out of it
+ *   score_tape      TAPE_SENSOR_TRIPPED, handled in ZoneInState
+ *   score_bump      as reload_bump, from ZoneInState
+ *   score_sweep     BEACON_LOST, ES_TIMEOUT, BEACON_FOUND through MiniRadar
+ *
+ * so the ns/op is the mean over the events of the cycle. Posts and timers go
+ * to bench/BenchStubs.c and are dropped.
+ *
+ * The framework's queues and ES_Timer tick are not in this tree, but the
+ * layers in front of them are: event_lanes_post_take files an event in
+ * TopHSM-style lanes and takes it back for the notice, event_mailbox_post_collect
+ * does the same through a mailbox slot and event_mailbox_replace posts twice
+ * before collecting, so the second replaces the first. service_host_post_run
+ * posts an ES_TIMEOUT to WheelCalService (idle) and runs the SERVICES_READY
+ * that delivers it.
+ *
+ * The ready_highest benchmarks find the highest ready service among 8, 16
+ * and 32 with ReadySet.h's clz and portable lookups, and with the nibble
+ * table walk the framework's ES_PriorTables lookup does, extended to the
+ * wider sets. The sets are sparse (one or two services ready), as they are
+ * at run time.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "TapeFrame.h"
+#include "ReadySet.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "TopHSM.h"
+#include "BatteryAdjust.h"
+#include "EventLanes.h"
+#include "EventMailbox.h"
+#include "ServiceHost.h"
+#include "WorldState.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define BENCH_MIN_NS 200000000ULL   // 0.2 s per benchmark
+#define BENCH_BATCH 1024            // iterations between clock reads
+#define NOISE_FRAMES 256            // power of two
+#define READY_SETS 256              // power of two
+#define TAPE_STATUSES 256           // power of two
+#define ARCHIVE_SIZE 10             // as in TapeSensorService.c
+#define MIDDLE_PAIR 0x0110          // tape status, both middle sensors on black
+#define SET_CYCLE(events) (cycle = events, cycle_length = sizeof (events) / sizeof (events[0]))
+
+// typical readings, flash off minus flash on is ~100 on black and ~700 on white
+#define OFF_READING 900
+#define BLACK_ON_READING 800
+#define WHITE_ON_READING 200
+#define BLACK_MEAN (100 << TAPE_MEAN_SHIFT)
+#define WHITE_MEAN (700 << TAPE_MEAN_SHIFT)
+
+// as in TapeSensorService.c before TapeFrame
+#define DRIFT_SHIFT 6
+#define MIN_DRIFT_SEPARATION (100 << TAPE_MEAN_SHIFT)
+#define HYSTERESIS_DIVISOR 4
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(uint32_t iteration);
+} Bench_t;
+
+// one sensor of the old tape_sensors[] array
+typedef struct {
+    uint16_t mask;
+    unsigned int sample1;   // flash on
+    unsigned int sample2;   // flash off
+    unsigned int diff;
+    tape_status status;
+    int32_t black_mean;
+    int32_t white_mean;
+    unsigned int black_threshold;
+    unsigned int white_threshold;
+} tape_sensor;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static uint64_t Now(void);
+static void RunBench(const Bench_t *bench);
+
+static void SetupFrame(void);
+static void SetupNoise(void);
+static void TapeInit(uint32_t iteration);
+static void TapeProcessSteady(uint32_t iteration);
+static void TapeProcessToggle(uint32_t iteration);
+static void TapeProcessNoise(uint32_t iteration);
+static void SetupSensors(void);
+static void SetupSensorNoise(void);
+static void SetSensorThresholds(tape_sensor *sensor);
+static void TrackSensorDrift(tape_sensor *sensor);
+static uint16_t ProcessSensors(void);
+static void SensorsSteady(uint32_t iteration);
+static void SensorsToggle(uint32_t iteration);
+static void SensorsNoise(uint32_t iteration);
+static void SetupReady(uint8_t services);
+static void SetupReady8(void);
+static void SetupReady16(void);
+static void SetupReady32(void);
+static uint8_t TableHighest(ReadySet_t set);
+static void ReadyTable(uint32_t iteration);
+static void ReadyClz(uint32_t iteration);
+static void ReadyPortable(uint32_t iteration);
+static void SetupNothing(void);
+static void AdjustSpeed(uint32_t iteration);
+static void SetupArchive(void);
+static void ArchiveMean(uint32_t iteration);
+static void MovingMean(uint32_t iteration);
+static void SetupTopHSM(void);
+static void TopHSMUnhandled(uint32_t iteration);
+static void TopHSMNoEvent(uint32_t iteration);
+static void Walk(const ES_Event *events, uint8_t length);
+static void SetupReload(void);
+static void SetupScore(void);
+static void SetupReloadTape(void);
+static void SetupReloadTimeout(void);
+static void SetupReloadBump(void);
+static void SetupReloadBeacon(void);
+static void SetupScoreTape(void);
+static void SetupScoreBump(void);
+static void SetupScoreSweep(void);
+static void TopHSMCycle(uint32_t iteration);
+static uint8_t Enqueue(ES_Event ThisEvent);
+static void LanesPostTake(uint32_t iteration);
+static void MailboxPostCollect(uint32_t iteration);
+static void MailboxReplace(uint32_t iteration);
+static void HostPostRun(uint32_t iteration);
+
+// TapeSensorService.c, not in its header
+extern uint16_t new_tape_data;
+extern uint16_t tape_archive[ARCHIVE_SIZE];
+uint16_t FindArchiveMean(void);
+uint16_t FindMovingMean(void);
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static uint64_t allocations;
+static volatile uint16_t sink;  // keeps results from being optimised away
+
+static TapeFrame_t frame;
+static uint16_t masks[TAPE_FRAME_CHANNELS];
+static uint16_t noise_on[NOISE_FRAMES][TAPE_FRAME_CHANNELS];
+static tape_sensor sensors[TAPE_FRAME_CHANNELS];
+
+static ReadySet_t ready_sets[READY_SETS];
+static uint8_t ready_services;
+
+static uint16_t tape_statuses[TAPE_STATUSES];
+
+// the cycle TopHSMCycle() dispatches from
+static const ES_Event *cycle;
+static uint8_t cycle_length;
+
+static EventLanes_t lanes = EVENT_LANES("Bench");
+static ES_Event queued;         // the last notice Enqueue() was given
+
+static const ES_Event InitToReload[] = {
+    {ES_TIMEOUT, INIT_TIMER}, {BEACON_FOUND, 0}, {ES_TIMEOUT, INIT_TIMER}, {ES_TIMEOUT, INIT_TIMER},
+};
+static const ES_Event ReloadToScore[] = {
+    {BALLS_LOADED, 0}, {ES_TIMEOUT, SCORE_TIMER}, {BEACON_FOUND, 0},
+};
+static const ES_Event TapeCycle[] = {
+    {TAPE_SENSOR_TRIPPED, MIDDLE_PAIR},
+};
+static const ES_Event TapeFollowTimeoutCycle[] = {
+    {ES_TIMEOUT, TAPE_FOLLOW_TIMER},
+};
+static const ES_Event BumpCycle[] = {
+    {BUMPER_TRIPPED, BUMP_LEFT_MASK}, {ES_TIMEOUT, BUMP_RES_TIMER}, {ES_TIMEOUT, BUMP_RES_TIMER},
+};
+static const ES_Event ReloadBeaconCycle[] = {
+    {BEACON_FOUND, 0}, {BEACON_LOST, 0},
+};
+static const ES_Event ScoreSweepCycle[] = {
+    {BEACON_LOST, 0}, {ES_TIMEOUT, SCORE_TIMER}, {BEACON_FOUND, 0},
+};
+
+// as in ES_PriorTables.h
+static const uint8_t Nybble2MSBitNum[16] = {0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3};
+
+static const Bench_t benches[] = {
+    {"tape_frame_init", SetupFrame, TapeInit},
+    {"tape_frame_process_steady", SetupFrame, TapeProcessSteady},
+    {"tape_frame_process_toggle", SetupFrame, TapeProcessToggle},
+    {"tape_frame_process_noise", SetupNoise, TapeProcessNoise},
+    {"tape_sensors_process_steady", SetupSensors, SensorsSteady},
+    {"tape_sensors_process_toggle", SetupSensors, SensorsToggle},
+    {"tape_sensors_process_noise", SetupSensorNoise, SensorsNoise},
+    {"adjust_pwm", SetupNothing, AdjustSpeed},
+    {"tape_archive_mean", SetupArchive, ArchiveMean},
+    {"tape_moving_mean", SetupArchive, MovingMean},
+    {"top_hsm_dispatch_unhandled", SetupTopHSM, TopHSMUnhandled},
+    {"top_hsm_dispatch_no_event", SetupTopHSM, TopHSMNoEvent},
+    {"top_hsm_reload_tape", SetupReloadTape, TopHSMCycle},
+    {"top_hsm_reload_timeout", SetupReloadTimeout, TopHSMCycle},
+    {"top_hsm_reload_bump", SetupReloadBump, TopHSMCycle},
+    {"top_hsm_reload_beacon", SetupReloadBeacon, TopHSMCycle},
+    {"top_hsm_score_tape", SetupScoreTape, TopHSMCycle},
+    {"top_hsm_score_bump", SetupScoreBump, TopHSMCycle},
+    {"top_hsm_score_sweep", SetupScoreSweep, TopHSMCycle},
+    {"event_lanes_post_take", SetupNothing, LanesPostTake},
+    {"event_mailbox_post_collect", SetupNothing, MailboxPostCollect},
+    {"event_mailbox_replace", SetupNothing, MailboxReplace},
+    {"service_host_post_run", SetupNothing, HostPostRun},
+    {"ready_highest_table_8", SetupReady8, ReadyTable},
+    {"ready_highest_table_16", SetupReady16, ReadyTable},
+    {"ready_highest_table_32", SetupReady32, ReadyTable},
+    {"ready_highest_clz_8", SetupReady8, ReadyClz},
+    {"ready_highest_clz_16", SetupReady16, ReadyClz},
+    {"ready_highest_clz_32", SetupReady32, ReadyClz},
+    {"ready_highest_portable_8", SetupReady8, ReadyPortable},
+    {"ready_highest_portable_16", SetupReady16, ReadyPortable},
+    {"ready_highest_portable_32", SetupReady32, ReadyPortable},
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv) {
+    uint8_t i;
+
+    printf("#BENCH begin %d\n", TAPE_FRAME_CHANNELS);
+    for (i = 0; i < sizeof (benches) / sizeof (benches[0]); i++) {
+        if (argc > 1 && strstr(benches[i].name, argv[1]) == NULL) continue;
+        RunBench(&benches[i]);
+    }
+    printf("#BENCH end\n");
+    return 0;
+}
+
+void *__wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+static uint64_t Now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void RunBench(const Bench_t *bench) {
+    uint64_t start, elapsed, allocated;
+    uint32_t iterations = 0, i;
+
+    bench->setup();
+    allocated = allocations;
+    start = Now();
+    do {
+        for (i = 0; i < BENCH_BATCH; i++) {
+            bench->run(iterations + i);
+        }
+        iterations += BENCH_BATCH;
+        elapsed = Now() - start;
+    } while (elapsed < BENCH_MIN_NS);
+    allocated = allocations - allocated;
+
+    printf("B %s %lu %.2f %.2f\n", bench->name, (unsigned long) iterations,
+            (double) elapsed / iterations, (double) allocated / iterations);
+}
+
+static void SetupFrame(void) {
+    uint8_t i;
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        masks[i] = 1 << (i % 16);
+    }
+    TapeFrame_Init(&frame, masks, BLACK_MEAN, WHITE_MEAN);
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        frame.off[i] = OFF_READING;
+        frame.on[i] = WHITE_ON_READING;
+    }
+}
+
+// readings spread over the whole range, so channels cross the band, sit in
+// it and drift their means
+static void SetupNoise(void) {
+    uint32_t seed = 1;
+    uint16_t f;
+    uint8_t i;
+
+    SetupFrame();
+    for (f = 0; f < NOISE_FRAMES; f++) {
+        for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+            seed = seed * 1103515245 + 12345;
+            noise_on[f][i] = BLACK_ON_READING - ((seed >> 16) % (BLACK_ON_READING - WHITE_ON_READING + 100));
+        }
+    }
+}
+
+static void TapeInit(uint32_t iteration) {
+    TapeFrame_Init(&frame, masks, BLACK_MEAN, WHITE_MEAN);
+    sink = frame.white_threshold[iteration % TAPE_FRAME_CHANNELS];
+}
+
+static void TapeProcessSteady(uint32_t iteration) {
+    (void) iteration;
+    sink = TapeFrame_Process(&frame);
+}
+
+// every channel flips between black and white on each frame
+static void TapeProcessToggle(uint32_t iteration) {
+    uint16_t on = (iteration & 0x01) ? BLACK_ON_READING : WHITE_ON_READING;
+    uint8_t i;
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        frame.on[i] = on;
+    }
+    sink = TapeFrame_Process(&frame);
+}
+
+static void TapeProcessNoise(uint32_t iteration) {
+    memcpy(frame.on, noise_on[iteration & (NOISE_FRAMES - 1)], sizeof (frame.on));
+    sink = TapeFrame_Process(&frame);
+}
+
+static void SetupSensors(void) {
+    uint8_t i;
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        sensors[i].mask = 1 << (i % 16);
+        sensors[i].black_mean = BLACK_MEAN;
+        sensors[i].white_mean = WHITE_MEAN;
+        SetSensorThresholds(&sensors[i]);
+        sensors[i].status = WHITE;
+        sensors[i].sample1 = WHITE_ON_READING;
+        sensors[i].sample2 = OFF_READING;
+    }
+}
+
+static void SetupSensorNoise(void) {
+    SetupSensors();
+    SetupNoise();
+}
+
+static void SetSensorThresholds(tape_sensor *sensor) {
+    int32_t mid = (sensor->black_mean + sensor->white_mean) >> (TAPE_MEAN_SHIFT + 1);
+    int32_t half_band = ((sensor->white_mean - sensor->black_mean) >> TAPE_MEAN_SHIFT) / HYSTERESIS_DIVISOR;
+    sensor->black_threshold = mid - half_band;
+    sensor->white_threshold = mid + half_band;
+}
+
+static void TrackSensorDrift(tape_sensor *sensor) {
+    int32_t reading = (sensor->diff > TAPE_ADC_MAX ? TAPE_ADC_MAX : sensor->diff) << TAPE_MEAN_SHIFT;
+    int32_t black = sensor->black_mean;
+    int32_t white = sensor->white_mean;
+
+    if (sensor->status == BLACK) {
+        black += (reading - black) >> DRIFT_SHIFT;
+    } else {
+        white += (reading - white) >> DRIFT_SHIFT;
+    }
+    if (white - black < MIN_DRIFT_SEPARATION) return;
+    sensor->black_mean = black;
+    sensor->white_mean = white;
+    SetSensorThresholds(sensor);
+}
+
+// TakeSecondSample(), UpdateStatus() and AssembleReadings() as they were
+static uint16_t ProcessSensors(void) {
+    uint16_t status = 0;
+    tape_sensor *sensor;
+    uint8_t i;
+
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        sensors[i].diff = sensors[i].sample2 - sensors[i].sample1;
+    }
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        sensor = &sensors[i];
+        if (sensor->diff > sensor->white_threshold) {
+            sensor->status = WHITE;
+            TrackSensorDrift(sensor);
+        } else if (sensor->diff < sensor->black_threshold) {
+            sensor->status = BLACK;
+            TrackSensorDrift(sensor);
+        }
+    }
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        if (sensors[i].status == BLACK) status |= sensors[i].mask;
+    }
+    return status;
+}
+
+static void SensorsSteady(uint32_t iteration) {
+    (void) iteration;
+    sink = ProcessSensors();
+}
+
+static void SensorsToggle(uint32_t iteration) {
+    unsigned int on = (iteration & 0x01) ? BLACK_ON_READING : WHITE_ON_READING;
+    uint8_t i;
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        sensors[i].sample1 = on;
+    }
+    sink = ProcessSensors();
+}
+
+static void SensorsNoise(uint32_t iteration) {
+    const uint16_t *on = noise_on[iteration & (NOISE_FRAMES - 1)];
+    uint8_t i;
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        sensors[i].sample1 = on[i];
+    }
+    sink = ProcessSensors();
+}
+
+static void SetupNothing(void) {
+}
+
+static void AdjustSpeed(uint32_t iteration) {
+    sink = AdjustPWM(iteration % 1000);
+}
+
+// the middle pair on the line most of the time, the outer sensors now and then
+static void SetupArchive(void) {
+    static const uint16_t statuses[] = {0x0110, 0x0110, 0x0110, 0x0100, 0x0010, 0x1100, 0x0011, 0x0000};
+    uint32_t seed = 1;
+    uint16_t i;
+
+    for (i = 0; i < TAPE_STATUSES; i++) {
+        seed = seed * 1103515245 + 12345;
+        tape_statuses[i] = statuses[(seed >> 16) % (sizeof (statuses) / sizeof (statuses[0]))];
+    }
+    for (i = 0; i < ARCHIVE_SIZE; i++) {
+        tape_archive[i] = tape_statuses[i];
+    }
+}
+
+static void ArchiveMean(uint32_t iteration) {
+    (void) iteration;
+    sink = FindArchiveMean();
+}
+
+static void MovingMean(uint32_t iteration) {
+    new_tape_data = tape_statuses[iteration & (TAPE_STATUSES - 1)];
+    sink = FindMovingMean();
+}
+
+// the boot transition, TopHSM and its sub machines start out as they do on
+// the target
+static void SetupTopHSM(void) {
+    InitTopHSM(0);
+    RunTopHSM(INIT_EVENT);
+}
+
+// an event no state handles walks the whole active chain
+static void TopHSMUnhandled(uint32_t iteration) {
+    ES_Event ThisEvent = {TW_PROX_FOUND, iteration % 1000};
+    sink = RunTopHSM(ThisEvent).EventType;
+}
+
+static void TopHSMNoEvent(uint32_t iteration) {
+    ES_Event ThisEvent = {ES_NO_EVENT, 0};
+    (void) iteration;
+    sink = RunTopHSM(ThisEvent).EventType;
+}
+
+static void Walk(const ES_Event *events, uint8_t length) {
+    uint8_t i;
+    for (i = 0; i < length; i++) {
+        RunTopHSM(events[i]);
+    }
+}
+
+// through the boot sequence, TapeFollowSM in MoveForward with the middle pair
+// on the tape
+static void SetupReload(void) {
+    SetupTopHSM();
+    Walk(InitToReload, sizeof (InitToReload) / sizeof (InitToReload[0]));
+    WorldState_UpdateTape(MIDDLE_PAIR);
+}
+
+// heading for the beacon
+static void SetupScore(void) {
+    SetupReload();
+    Walk(ReloadToScore, sizeof (ReloadToScore) / sizeof (ReloadToScore[0]));
+}
+
+static void SetupReloadTape(void) {
+    SetupReload();
+    SET_CYCLE(TapeCycle);
+}
+
+static void SetupReloadTimeout(void) {
+    SetupReload();
+    SET_CYCLE(TapeFollowTimeoutCycle);
+}
+
+static void SetupReloadBump(void) {
+    SetupReload();
+    SET_CYCLE(BumpCycle);
+}
+
+static void SetupReloadBeacon(void) {
+    SetupReload();
+    SET_CYCLE(ReloadBeaconCycle);
+}
+
+static void SetupScoreTape(void) {
+    SetupScore();
+    SET_CYCLE(TapeCycle);
+}
+
+static void SetupScoreBump(void) {
+    SetupScore();
+    SET_CYCLE(BumpCycle);
+}
+
+static void SetupScoreSweep(void) {
+    SetupScore();
+    SET_CYCLE(ScoreSweepCycle);
+}
+
+static void TopHSMCycle(uint32_t iteration) {
+    sink = RunTopHSM(cycle[iteration % cycle_length]).EventType;
+}
+
+// stands in for the framework queue, which would hand the notice back
+static uint8_t Enqueue(ES_Event ThisEvent) {
+    queued = ThisEvent;
+    return TRUE;
+}
+
+static void LanesPostTake(uint32_t iteration) {
+    ES_Event ThisEvent = {TAPE_SENSOR_TRIPPED, iteration & 0x1111};
+    EventLanes_Post(&lanes, LANE_NORMAL, Enqueue, ThisEvent);
+    sink = EventLanes_Take(&lanes, queued).EventParam;
+}
+
+static void MailboxPostCollect(uint32_t iteration) {
+    ES_Event ThisEvent = {TAPE_SENSOR_TRIPPED, iteration & 0x1111};
+    EventMailbox_Post(Enqueue, ThisEvent);
+    sink = EventMailbox_Collect(Enqueue, queued).EventParam;
+}
+
+static void MailboxReplace(uint32_t iteration) {
+    ES_Event ThisEvent = {TAPE_SENSOR_TRIPPED, iteration & 0x1111};
+    EventMailbox_Post(Enqueue, ThisEvent);
+    ThisEvent.EventParam ^= MIDDLE_PAIR;
+    EventMailbox_Post(Enqueue, ThisEvent);
+    sink = EventMailbox_Collect(Enqueue, queued).EventParam;
+}
+
+// WheelCalService is hosted service 0, left uninitialised so its Init does
+// not print into the results
+static void HostPostRun(uint32_t iteration) {
+    ES_Event ThisEvent = {ES_TIMEOUT, WHEEL_CAL_TIMER};
+    ES_Event Notice = {SERVICES_READY, 0};
+    (void) iteration;
+    ServiceHost_Post(0, ThisEvent);
+    sink = RunServiceHost(Notice).EventType;
+}
+
+// one or two of the services ready, anywhere in the set
+static void SetupReady(uint8_t services) {
+    uint32_t seed = 1;
+    uint16_t i;
+
+    ready_services = services;
+    for (i = 0; i < READY_SETS; i++) {
+        seed = seed * 1103515245 + 12345;
+        ready_sets[i] = 0;
+        ReadySet_Add(ready_sets[i], (seed >> 16) % services);
+        if (seed & 0x01) ReadySet_Add(ready_sets[i], (seed >> 24) % services);
+    }
+}
+
+static void SetupReady8(void) {
+    SetupReady(8);
+}
+
+static void SetupReady16(void) {
+    SetupReady(16);
+}
+
+static void SetupReady32(void) {
+    SetupReady(32);
+}
+
+// walks down a nibble at a time from the top of the configured set
+static uint8_t TableHighest(ReadySet_t set) {
+    uint8_t shift = ready_services - 4;
+
+    while (shift > 0 && (set >> shift) == 0) {
+        shift -= 4;
+    }
+    return shift + Nybble2MSBitNum[(set >> shift) & 0x0F];
+}
+
+static void ReadyTable(uint32_t iteration) {
+    sink = TableHighest(ready_sets[iteration & (READY_SETS - 1)]);
+}
+
+static void ReadyClz(uint32_t iteration) {
+    sink = ReadySet_Highest(ready_sets[iteration & (READY_SETS - 1)]);
+}
+
+static void ReadyPortable(uint32_t iteration) {
+    sink = ReadySet_HighestPortable(ready_sets[iteration & (READY_SETS - 1)]);
+}
@@ -0,0 +1,228 @@
+import sys
+import os
+import subprocess
+import logging
+
+# Bench.py
+#
+# Builds Bench.c with the host gcc, once per tape channel count, runs it and
+# prints the results in Bench.c's line format (save them with -o to compare
+# later). With -c, compares two saved runs benchmark by benchmark.
+#
+# Any benchmark that allocates fails the run, the hot paths must not.
+#
+# With -t, tabulates the on-target results that a CYCLE_BENCH build prints at
+# boot (see CycleBench.c), next to host results of the same kernels if given.
+#
+# usage: python Bench.py [-n 4,6,8,16] [-o results.txt] [name filter]   (run from the project directory)
+#        python Bench.py -c base.txt new.txt
+#        python Bench.py -t target.log [host.txt]
+#        python Bench.py -t -p COM3 [host.txt]     (waits for the board to boot, needs pyserial)
+
+Compiler = 'gcc'
+Flags = ['-std=gnu99', '-O2', '-I.', '-Ibench']
+Warnings = ['-Wall', '-Wextra']
+Wrapped = ['malloc', 'calloc', 'realloc']
+# built once per channel count
+Sources = ['Bench.c', 'TapeFrame.c', os.path.join('bench', 'BenchStubs.c')]
+# the project modules the benchmarks link, built once with the same Warnings
+Linked = ['TopHSM.c', 'InitSubHSM.c', 'ReloadSubHSM.c', 'ScoreSubHSM.c', 'DepositBallsSM.c',
+		'TapeFollowSM.c', 'BumpResService.c', 'ReceiveService.c', 'ExclusionRadar.c',
+		'WorldState.c', 'StateStats.c', 'HSMSupervisor.c', 'HSMHistory.c', 'HSMDefer.c',
+		'EventPool.c', 'EventMailbox.c', 'EventLanes.c', 'SerialTx.c', 'SensorRate.c',
+		'BootProfile.c', 'ServiceHost.c', 'ES_Hosted.c', 'WheelCalService.c',
+		'TapeSensorService.c', 'BatteryAdjust.c', 'ES_Names.c',
+		os.path.join('..', 'Motor_test', 'motors.c')]
+# warnings the course templates and the original state machines already had
+# (the unused MyPriority, falling from the tape case into the timeout case,
+# switches on part of the event enum), turned off for their module only so
+# that anything else still shows
+Baseline = {
+	'InitSubHSM.c': ['unused-variable'],
+	'ReloadSubHSM.c': ['unused-variable'],
+	'ScoreSubHSM.c': ['unused-variable', 'switch'],
+	'TapeFollowSM.c': ['unused-variable', 'implicit-fallthrough'],
+	'BumpResService.c': ['unused-variable'],
+	'ReceiveService.c': ['unused-variable', 'unused-parameter', 'implicit-fallthrough'],
+	'ExclusionRadar.c': ['unused-variable', 'implicit-fallthrough'],
+	'TapeSensorService.c': ['switch'],
+}
+DefaultChannels = [4, 6, 8, 16]
+CyclesPerTick = 2   # the PIC32 core timer counts every other cycle
+OutDir = os.path.join('build', 'bench')
+Threshold = 5.0   # % change worth pointing out
+
+
+# returns {(name, channels): (iterations, ns/op, allocations/op)}
+def parseResults(lines):
+	results = {}
+	channels = None
+	for line in lines:
+		fields = line.split()
+		if not fields:
+			continue
+		if fields[0] == '#BENCH' and len(fields) > 2 and fields[1] == 'begin':
+			channels = int(fields[2])
+		elif fields[0] == '#BENCH':
+			channels = None
+		elif fields[0] == 'B' and len(fields) == 5 and channels is not None:
+			results[(fields[1], channels)] = (int(fields[2]), float(fields[3]), float(fields[4]))
+	return results
+
+
+# returns (channels, core timer Hz, {name: (iterations, ticks)}) of the last
+# complete target run, or None
+def parseTarget(lines):
+	last = None
+	current = None
+	for line in lines:
+		fields = line.split()
+		if not fields:
+			continue
+		if fields[0] == '#BENCH' and len(fields) == 5 and fields[1] == 'begin' and fields[3] == 'target':
+			current = (int(fields[2]), int(fields[4]), {})
+		elif fields[0] == '#BENCH' and len(fields) > 1 and fields[1] == 'end' and current is not None:
+			last = current
+			current = None
+		elif fields[0] == 'T' and len(fields) == 4 and current is not None:
+			current[2][fields[1]] = (int(fields[2]), int(fields[3]))
+	return last
+
+
+def readSerial(port):
+	import serial
+	lines = []
+	with serial.Serial(port, 115200, timeout=30) as link:
+		while True:
+			line = link.readline().decode('ascii', 'replace')
+			if line == '':
+				break
+			lines.append(line)
+			if line.startswith('#BENCH end'):
+				break
+	return lines
+
+
+def tabulate(target, host):
+	channels, hz, kernels = target
+	print('%-32s %10s %10s %10s' % ('kernel (%d ch)' % channels, 'cycles', 'target ns', 'host ns'))
+	for name in sorted(kernels):
+		iterations, ticks = kernels[name]
+		hostResult = host.get((name, channels))
+		print('%-32s %10.1f %10.1f %10s' % (name, float(ticks) * CyclesPerTick / iterations,
+				1e9 * ticks / hz / iterations, '%.2f' % hostResult[1] if hostResult else '-'))
+
+
+# returns the object files of Linked
+def buildLinked():
+	objects = []
+	objDir = os.path.join(OutDir, 'linked')
+	if not os.path.isdir(objDir):
+		os.makedirs(objDir)
+	for source in Linked:
+		obj = os.path.join(objDir, os.path.splitext(os.path.basename(source))[0] + '.o')
+		quiet = ['-Wno-' + name for name in Baseline.get(os.path.basename(source), [])]
+		subprocess.check_call([Compiler] + Flags + Warnings + quiet + ['-c', source, '-o', obj])
+		objects.append(obj)
+	return objects
+
+
+def build(channels, objects):
+	binary = os.path.join(OutDir, 'bench_%d' % channels)
+	command = [Compiler] + Flags + Warnings + ['-DTAPE_FRAME_CHANNELS=%d' % channels] + Sources + \
+			objects + ['-Wl,' + ','.join('--wrap=' + name for name in Wrapped), '-o', binary]
+	subprocess.check_call(command)
+	return binary
+
+
+def run(channelList, nameFilter):
+	lines = []
+	objects = buildLinked()
+	for channels in channelList:
+		command = [build(channels, objects)]
+		if nameFilter:
+			command.append(nameFilter)
+		output = subprocess.check_output(command).decode('ascii')
+		lines.extend(output.splitlines())
+	return lines
+
+
+def compare(base, new):
+	print('%-32s %4s %10s %10s %8s' % ('benchmark', 'ch', 'base ns', 'new ns', 'change'))
+	for key in sorted(set(base) | set(new)):
+		name, channels = key
+		if key not in base or key not in new:
+			print('%-32s %4d %10s %10s %8s' % (name, channels,
+					'%.2f' % base[key][1] if key in base else '-',
+					'%.2f' % new[key][1] if key in new else '-', ''))
+			continue
+		before, after = base[key][1], new[key][1]
+		change = 100.0 * (after - before) / before if before else 0.0
+		print('%-32s %4d %10.2f %10.2f %+7.1f%%%s' % (name, channels, before, after, change,
+				'  <--' if abs(change) >= Threshold else ''))
+
+
+# names of the benchmarks that allocated
+def allocating(results):
+	return sorted('%s/%d' % key for key, value in results.items() if value[2] > 0)
+
+
+def main(argv):
+	if len(argv) == 3 and argv[0] == '-c':
+		results = []
+		for fileName in argv[1:]:
+			with open(fileName, 'r') as f:
+				results.append(parseResults(f.readlines()))
+		compare(results[0], results[1])
+		return 0
+	if argv and argv[0] == '-t':
+		args = list(argv[1:])
+		if len(args) > 1 and args[0] == '-p':
+			args.pop(0)
+			lines = readSerial(args.pop(0))
+		elif args:
+			with open(args.pop(0), 'r') as f:
+				lines = f.readlines()
+		else:
+			lines = []
+		target = parseTarget(lines)
+		if target is None:
+			logging.error('no complete target run')
+			return 1
+		host = {}
+		if args:
+			with open(args[0], 'r') as f:
+				host = parseResults(f.readlines())
+		tabulate(target, host)
+		return 0
+
+	channelList = DefaultChannels
+	outName = None
+	nameFilter = None
+	args = list(argv)
+	while args:
+		arg = args.pop(0)
+		if arg == '-n':
+			channelList = [int(n) for n in args.pop(0).split(',')]
+		elif arg == '-o':
+			outName = args.pop(0)
+		else:
+			nameFilter = arg
+
+	lines = run(channelList, nameFilter)
+	for line in lines:
+		print(line)
+	if outName:
+		with open(outName, 'w') as f:
+			f.write('\n'.join(lines) + '\n')
+
+	bad = allocating(parseResults(lines))
+	for name in bad:
+		logging.error('%s allocates' % name)
+	return 1 if bad else 0
+
+
+if __name__ == '__main__':
+	logging.basicConfig(level=logging.INFO, format='[%(levelname)s]%(asctime)s: %(message)s',
+			stream=sys.stdout)
+	sys.exit(main(sys.argv[1:]))
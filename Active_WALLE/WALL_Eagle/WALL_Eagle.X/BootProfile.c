@@ -0,0 +1,119 @@
+/*
+ * File:   BootProfile.c
+ *
+ * Boot step stamps and the fast-start hand-off, see BootProfile.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <xc.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "TopHSM.h"
+#include "SerialTx.h"
+#include "BootProfile.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define TICKS_PER_US (80 / 2)   // the core timer counts every other SYSCLK
+#define StepBit(step) ((uint32_t) 1 << (step))
+#define WARM_STEPS (StepBit(BOOT_TAPE_WARM) | StepBit(BOOT_BUMPER_WARM) | \
+                    StepBit(BOOT_TRACK_WIRE_WARM) | StepBit(BOOT_BEACON_WARM))
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static void PostWarm(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static const char * const StepNames[NUM_BOOT_STEPS] = {
+    [BOOT_BOARD_INIT] = "BOARD_Init",
+    [BOOT_AD_INIT] = "AD_Init",
+    [BOOT_PWM_INIT] = "PWM_Init",
+    [BOOT_RC_INIT] = "RC_Init",
+    [BOOT_BANNER] = "banner",
+    [BOOT_PINS] = "pins",
+    [BOOT_ES_INITIALIZE] = "ES_Initialize",
+    [BOOT_ES_RUN] = "ES_Run",
+    [BOOT_TOP_HSM] = "TopHSM",
+    [BOOT_TAPE_SERVICE] = "TapeSensorService",
+    [BOOT_BUMPER_SERVICE] = "BumperService",
+    [BOOT_TRACK_WIRE_SERVICE] = "TrackWireService",
+    [BOOT_TAPE_WARM] = "tape_warm",
+    [BOOT_BUMPER_WARM] = "bumper_warm",
+    [BOOT_TRACK_WIRE_WARM] = "track_wire_warm",
+    [BOOT_BEACON_WARM] = "beacon_warm",
+    [BOOT_SENSORS_WARM] = "sensors_warm",
+    [BOOT_RADAR] = "radar",
+    [BOOT_INIT_DONE] = "INIT_DONE",
+};
+
+static uint32_t start;                  // core timer at BootProfile_Start()
+static uint32_t stamps[NUM_BOOT_STEPS]; // core timer ticks from start
+static uint32_t marked;                 // StepBit() of every stamped step
+static uint8_t awaiting = FALSE;        // SENSORS_WARM is owed to TopHSM
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void BootProfile_Start(void) {
+    start = _CP0_GET_COUNT();
+    marked = 0;
+}
+
+void BootProfile_Mark(BootStep_t step) {
+    uint32_t now = _CP0_GET_COUNT();
+
+    if (step >= NUM_BOOT_STEPS || (marked & StepBit(step))) return;
+    stamps[step] = now - start;
+    marked |= StepBit(step);
+
+    if (step == BOOT_INIT_DONE) {
+        SerialTx_Printf("\r\nBoot: INIT_DONE after %lu ms",
+                (unsigned long) (stamps[step] / TICKS_PER_US / 1000));
+    }
+    if ((marked & WARM_STEPS) == WARM_STEPS && !(marked & StepBit(BOOT_SENSORS_WARM))) {
+        BootProfile_Mark(BOOT_SENSORS_WARM);
+        if (awaiting) PostWarm();
+    }
+}
+
+void BootProfile_AwaitWarm(void) {
+#ifdef FAST_START
+    if (marked & StepBit(BOOT_SENSORS_WARM)) {
+        PostWarm();
+    } else {
+        awaiting = TRUE;
+    }
+#endif
+}
+
+void BootProfile_Dump(void) {
+    uint8_t i;
+
+    for (i = 0; i < NUM_BOOT_STEPS; i++) {
+        if (!(marked & StepBit(i))) continue;
+        printf("\r\nB %s %lu", StepNames[i], (unsigned long) (stamps[i] / TICKS_PER_US));
+    }
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+static void PostWarm(void) {
+    ES_Event ThisEvent;
+
+    awaiting = FALSE;
+    ThisEvent.EventType = SENSORS_WARM;
+    ThisEvent.EventParam = 0;
+    PostTopHSM(ThisEvent);
+}
@@ -0,0 +1,102 @@
+/*
+ * File:   BootProfile.h
+ *
+ * Where the time goes between reset and INIT_DONE. main() stamps each of its
+ * init steps, each service stamps the first event it runs and each sensor the
+ * first reading it takes after its startup hold, InitSubHSM stamps the start
+ * of the beacon search and TopHSM INIT_DONE. Stamps come from the core timer
+ * and count from BootProfile_Start() at the top of main(), so the C startup
+ * code before it is not included. Only the first stamp of a step is kept.
+ *
+ * BootProfile_Dump() prints them with the 's' stats dump, in us:
+ *
+ *   B <step> <us>
+ *
+ * and INIT_DONE is logged when it happens.
+ *
+ * The sensor services already hold off their first sample while
+ * InitDelayState spins, so the warm-up itself is not on the boot path; the
+ * fixed INIT_DELAY_TIME spin is. With FAST_START defined the spin ends as
+ * soon as every sensor has taken its first reading (BOOT_SENSORS_WARM, about
+ * 500 ms after the services start) instead, and the beacon search starts
+ * that much earlier. INIT_DELAY_TIME stays as the upper bound.
+ */
+
+#ifndef BOOTPROFILE_H
+#define	BOOTPROFILE_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+// define to end the initial spin as soon as the sensors are warm
+//#define FAST_START
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef enum {
+    BOOT_BOARD_INIT,
+    BOOT_AD_INIT,
+    BOOT_PWM_INIT,
+    BOOT_RC_INIT,
+    BOOT_BANNER,
+    BOOT_PINS,
+    BOOT_ES_INITIALIZE,         // every service's Init
+    BOOT_ES_RUN,                // sensor tier started, entering ES_Run()
+    BOOT_TOP_HSM,
+    BOOT_TAPE_SERVICE,          // first event of each service
+    BOOT_BUMPER_SERVICE,
+    BOOT_TRACK_WIRE_SERVICE,
+    BOOT_TAPE_WARM,             // first reading of each sensor
+    BOOT_BUMPER_WARM,
+    BOOT_TRACK_WIRE_WARM,
+    BOOT_BEACON_WARM,
+    BOOT_SENSORS_WARM,          // the last of the four above
+    BOOT_RADAR,                 // InitSubHSM starts looking for the beacon
+    BOOT_INIT_DONE,
+    NUM_BOOT_STEPS,
+} BootStep_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function BootProfile_Start(void)
+ * @return None
+ * @brief Sets time zero, first thing in main(). */
+void BootProfile_Start(void);
+
+/**
+ * @Function BootProfile_Mark(BootStep_t step)
+ * @param step - the step that just finished
+ * @return None
+ * @brief Stamps step unless it already has a stamp, from the loop only. */
+void BootProfile_Mark(BootStep_t step);
+
+/**
+ * @Function BootProfile_AwaitWarm(void)
+ * @return None
+ * @brief With FAST_START, posts SENSORS_WARM to TopHSM once every sensor has
+ *        taken its first reading, at once if they already have. Does nothing
+ *        otherwise. */
+void BootProfile_AwaitWarm(void);
+
+/**
+ * @Function BootProfile_Dump(void)
+ * @return None
+ * @brief Prints the B lines for the steps stamped so far. */
+void BootProfile_Dump(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* BOOTPROFILE_H */
@@ -34,6 +34,9 @@
 #include "timers.h"
 #include "BumpResService.h"
 #include "stdio.h"
+#include "SerialTx.h"
+#include "StateStats.h"
+#include "motors.h"
 
 
 /*******************************************************************************
@@ -53,7 +56,7 @@ typedef enum {
     TurnLeft,
 } BumperResState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"MoveBack",
 	"TurnRight",
@@ -74,11 +77,10 @@ static const char *StateNames[] = {
 /* You will need MyPriority and the state variable; you may need others as well.
  * The type of state variable should match that of enum in header file. */
 
-static BumperResState_t CurrentState = InitPSubState; // <- change name to match ENUM
+// the state lives in each BumpResService_t, instances share the telemetry
+STATE_STATS(Stats, "BumpResService", StateNames);
 static uint8_t MyPriority;
 
-uint8_t last_hit = 0;
-
 
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
@@ -94,12 +96,13 @@ uint8_t last_hit = 0;
  *        to rename this to something appropriate.
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
-uint8_t InitBumpResService(uint8_t last_hit_received) {
+uint8_t InitBumpResService(BumpResService_t *me, uint8_t last_hit_received) {
     ES_Event returnEvent;
     TIMERS_Init();
-    CurrentState = InitPSubState;
-    last_hit = last_hit_received;
-    returnEvent = RunBumpResService(INIT_EVENT);
+    me->state = InitPSubState;
+    StateStats_Enter(&Stats, me->state);
+    me->last_hit = last_hit_received;
+    returnEvent = RunBumpResService(me, INIT_EVENT);
     if (returnEvent.EventType == ES_NO_EVENT) {
         return TRUE;
     }
@@ -121,13 +124,17 @@ uint8_t InitBumpResService(uint8_t last_hit_received) {
  *       not consumed as these need to pass pack to the higher level state machine.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
-ES_Event RunBumpResService(ES_Event ThisEvent) {
+ES_Event RunBumpResService(BumpResService_t *me, ES_Event ThisEvent) {
     uint8_t makeTransition = FALSE; // use to flag transition
     BumperResState_t nextState; // <- change type to correct enum
 
     ES_Tattle(); // trace call stack
 
-    switch (CurrentState) {
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
+    }
+
+    switch (me->state) {
         case InitPSubState: // If current state is initial Psedudo State
             if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
             {
@@ -143,15 +150,15 @@ ES_Event RunBumpResService(ES_Event ThisEvent) {
             break;
 
         case MoveBack: // in the first state, replace this with correct names
-            printf("\n<<1>>\n");
+            SerialTx_Printf("\n<<1>>\n");
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    ES_Timer_InitTimer(BUMP_RES_TIMER, MOVE_TIME);
+                    ES_Timer_InitTimer(me->timer, MOVE_TIME);
 
                     break;
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == BUMP_RES_TIMER) {
-                        if (last_hit == 0x01) {
+                    if (ThisEvent.EventParam == me->timer) {
+                        if (me->last_hit == 0x01) {
                             nextState = TurnLeft;
                             makeTransition = TRUE;
                         }
@@ -167,14 +174,14 @@ ES_Event RunBumpResService(ES_Event ThisEvent) {
             }
             break;
         case TurnLeft: // in the first state, replace this with correct names
-            printf("\n<<2>>\n");
+            SerialTx_Printf("\n<<2>>\n");
             BotTankTurnLeft(300);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    ES_Timer_InitTimer(BUMP_RES_TIMER, MOVE_TIME);
+                    ES_Timer_InitTimer(me->timer, MOVE_TIME);
                     break;
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == BUMP_RES_TIMER) {
+                    if (ThisEvent.EventParam == me->timer) {
                         ThisEvent.EventType = BUMP_RESOLVED;
                         ThisEvent.EventParam = 0x0;
                         nextState = InitPSubState;
@@ -186,14 +193,14 @@ ES_Event RunBumpResService(ES_Event ThisEvent) {
             }
             break;
         case TurnRight: // in the first state, replace this with correct names
-            printf("\n<<3>>\n");
+            SerialTx_Printf("\n<<3>>\n");
             BotTankTurnRight(300);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    ES_Timer_InitTimer(BUMP_RES_TIMER, MOVE_TIME);
+                    ES_Timer_InitTimer(me->timer, MOVE_TIME);
                     break;
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == BUMP_RES_TIMER) {
+                    if (ThisEvent.EventParam == me->timer) {
                         ThisEvent.EventType = BUMP_RESOLVED;
                         ThisEvent.EventParam = 0x0;
                         nextState = InitPSubState;
@@ -210,9 +217,10 @@ ES_Event RunBumpResService(ES_Event ThisEvent) {
     //
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
-        RunBumpResService(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunBumpResService(ENTRY_EVENT); // <- rename to your own Run function
+        RunBumpResService(me, EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
+        me->state = nextState;
+        RunBumpResService(me, ENTRY_EVENT); // <- rename to your own Run function
     }
 
     ES_Tail(); // trace call stack end
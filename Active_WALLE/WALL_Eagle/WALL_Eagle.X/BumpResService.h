@@ -30,20 +30,27 @@
 /*******************************************************************************
  * PUBLIC #DEFINES                                                             *
  ******************************************************************************/
-
+// initializer for a BumpResService_t, Init still has to run before the first Run
+#define BUMP_RES_SERVICE(timer) {0, 0, timer}
 
 /*******************************************************************************
  * PUBLIC TYPEDEFS                                                             *
  ******************************************************************************/
-
+/* One bump resolver, owned by the parent state machine like TapeFollowSM_t. */
+typedef struct {
+    uint8_t state;          // current state, only BumpResService.c knows the values
+    uint8_t last_hit;       // bumper param of the hit being resolved
+    uint8_t timer;          // state timeouts
+} BumpResService_t;
 
 /*******************************************************************************
  * PUBLIC FUNCTION PROTOTYPES                                                  *
  ******************************************************************************/
 
 /**
- * @Function InitTemplateSubHSM(void)
- * @param Priority - internal variable to track which event queue to use
+ * @Function InitBumpResService(BumpResService_t *me, uint8_t last_hit_received)
+ * @param me - the instance to (re)start
+ * @param last_hit_received - bumper param of the hit, picks the turn direction
  * @return TRUE or FALSE
  * @brief This will get called by the framework at the beginning of the code
  *        execution. It will post an ES_INIT event to the appropriate event
@@ -51,10 +58,11 @@
  *        to rename this to something appropriate.
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
-uint8_t InitBumpResService(uint8_t last_hit_received);
+uint8_t InitBumpResService(BumpResService_t *me, uint8_t last_hit_received);
 
 /**
- * @Function RunTemplateSubHSM(ES_Event ThisEvent)
+ * @Function RunBumpResService(BumpResService_t *me, ES_Event ThisEvent)
+ * @param me - the instance to run
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
  * @brief This function is where you implement the whole of the heirarchical state
@@ -68,7 +76,7 @@ uint8_t InitBumpResService(uint8_t last_hit_received);
  *       not consumed as these need to pass pack to the higher level state machine.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
-ES_Event RunBumpResService(ES_Event ThisEvent);
+ES_Event RunBumpResService(BumpResService_t *me, ES_Event ThisEvent);
 
 #endif /* BUMP_RES_SERVICE_H */
 
@@ -12,7 +12,13 @@
 #include "ES_Timers.h"
 #include "IO_Ports.h"
 #include <stdio.h>
+#include "SerialTx.h"
 #include "PinsMaster.h"
+#include "EventPool.h"
+#include "WorldState.h"
+#include "ADFrame.h"
+#include "SensorRate.h"
+#include "BootProfile.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -23,6 +29,9 @@
 #define HIGH_THRESHOLD 800
 #define LOW_THRESHOLD 200
 
+#define STARTUP_HOLD_TIME 25
+#define TRIPPED_HOLD_TIME 500
+
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
  ******************************************************************************/
@@ -46,6 +55,9 @@ uint8_t old_state = 0;
 uint8_t new_state = 0;
 char output[32];
 
+static ADFrame_Reader_t reader;
+static uint8_t holding = TRUE;  // ignore frames until BUMPER_TIMER expires
+
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
  ******************************************************************************/
@@ -58,8 +70,9 @@ uint8_t InitBumperService(uint8_t Priority) {
     
     //AD_AddPins(AD_ActivePins() | LEFT_BUMPER_PIN | RIGHT_BUMPER_PIN);
 
-    // Start the timer and let it run expiring every 2 ms
-    ES_Timer_InitTimer(BUMPER_TIMER, 25);
+    // sampling runs off AD_FRAME_READY once the startup hold is over
+    ADFrame_Subscribe(PostBumperService);
+    ES_Timer_InitTimer(BUMPER_TIMER, STARTUP_HOLD_TIME);
 
     ThisEvent.EventType = ES_INIT;
     if (ES_PostToService(MyPriority, ThisEvent) == TRUE) {
@@ -82,6 +95,9 @@ ES_Event RunBumperService(ES_Event ThisEvent) {
      *******************************************/
     static ES_EventTyp_t lastEvent = WHITE_TAPE_DETECTED;
     ES_EventTyp_t curEvent;
+    uint16_t handle;
+    SensorPayload_t *payload;
+    const ADFrame_t *sample;
 
     switch (ThisEvent.EventType) {
         case ES_TIMERACTIVE:
@@ -90,14 +106,19 @@ ES_Event RunBumperService(ES_Event ThisEvent) {
             // go in the init function above.
             //
             // This section is used to reset service for some reason
+            BootProfile_Mark(BOOT_BUMPER_SERVICE);
             break;
 
         case ES_TIMEOUT:
-            //printf("*");
-            ES_Timer_InitTimer(BUMPER_TIMER, 25);
-            if (AD_IsNewDataReady()) {
-                uint16_t left_bumper_val = AD_ReadADPin(LEFT_BUMPER_PIN);
-                uint16_t right_bumper_val = AD_ReadADPin(RIGHT_BUMPER_PIN);
+            holding = FALSE;
+            break;
+
+        case AD_FRAME_READY:
+            sample = (holding || !SensorRate_Due(SENSOR_BUMPER)) ? NULL : ADFrame_Next(&reader);
+            if (sample != NULL) {
+                BootProfile_Mark(BOOT_BUMPER_WARM);
+                uint16_t left_bumper_val = ADFrame_Read(sample, LEFT_BUMPER_PIN);
+                uint16_t right_bumper_val = ADFrame_Read(sample, RIGHT_BUMPER_PIN);
                 //printf("|\tR: %d\tL: %d\t|\n", right_bumper_val, left_bumper_val);
 
                 uint8_t new_state = 0b0000;
@@ -116,14 +137,27 @@ ES_Event RunBumperService(ES_Event ThisEvent) {
 
                 // Small state machine transitions between states every 2 ms at the timeout
                 if (old_state != new_state) {
-                    printf("[Bumper Status: %04x]\n", new_state);
+                    SerialTx_Printf("[Bumper Status: %04x]\n", new_state);
                     old_state = new_state;
+                    WorldState_UpdateBumper(old_state);
                     if (old_state) {
                         ReturnEvent.EventType = BUMPER_TRIPPED;
                         ReturnEvent.EventParam = old_state;
                     }
-                    PostTopHSM(ReturnEvent);
-                    ES_Timer_InitTimer(BUMPER_TIMER, 500);
+                    handle = EventPool_Alloc();
+                    payload = EventPool_Get(handle);
+                    if (old_state && payload != NULL) {
+                        payload->timestamp = ES_Timer_GetTime();
+                        payload->status = old_state;
+                        payload->bumper[0] = left_bumper_val;
+                        payload->bumper[1] = right_bumper_val;
+                        EventPool_Post(PostTopHSM, BUMPER_TRIPPED, handle);
+                    } else {
+                        EventPool_Release(handle);
+                        PostTopHSM(ReturnEvent);
+                    }
+                    holding = TRUE;
+                    ES_Timer_InitTimer(BUMPER_TIMER, TRIPPED_HOLD_TIME);
                 }
                 break;
                 //#ifdef SIMPLESERVICE_TEST     // keep this as is for test harness      
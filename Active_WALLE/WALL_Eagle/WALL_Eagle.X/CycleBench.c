@@ -0,0 +1,248 @@
+/*
+ * File:   CycleBench.c
+ *
+ * On-target benchmark harness. Like the EVENTCHECKER_TEST harness this is
+ * conditionally compiled: define CYCLE_BENCH at the project level and this
+ * main() replaces the one in main.c. It runs a fixed suite of kernels once at
+ * boot, timed with the core timer, and prints the results over serial in the
+ * same framing Bench.c uses on the host:
+ *
+ *   #BENCH begin <tape channels> target <core timer Hz>
+ *   T <name> <iterations> <core timer ticks>
+ *   #BENCH end
+ *
+ * "python Bench.py -t log [host results]" turns the ticks into cycles and ns
+ * per op and lines them up with the host numbers of the same kernels.
+ *
+ * The motor kernels drive the PWM pins, run it with the wheels off the ground.
+ */
+
+#ifdef CYCLE_BENCH
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <BOARD.h>
+#include <xc.h>
+#include <stdio.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Queue.h"
+#include "serial.h"
+#include "AD.h"
+#include "PinsMaster.h"
+#include "TopHSM.h"
+#include "EventPool.h"
+#include "TapeFrame.h"
+#include "ReadySet.h"
+#include "SerialTx.h"
+#include "BatteryAdjust.h"
+#include "motors.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define CORE_TIMER_HZ (80000000L / 2)   // the core timer counts every other SYSCLK
+#define BENCH_ITERATIONS 1000
+#define TRACE_ITERATIONS 50             // each one is a line on the terminal
+#define BENCH_QUEUE_SIZE 4
+
+#define BLACK_MEAN (100 << TAPE_MEAN_SHIFT)
+#define WHITE_MEAN (700 << TAPE_MEAN_SHIFT)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+typedef struct {
+    const char *name;
+    uint16_t iterations;
+    void (*run)(uint16_t iteration);
+} Kernel_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static void RunKernel(const Kernel_t *kernel);
+static void SetupKernels(void);
+static void WaitForTransmit(void);
+
+static void EventQueueFIFO(uint16_t iteration);
+static void EventPoolAllocRelease(uint16_t iteration);
+static void TopHSMDispatchUnhandled(uint16_t iteration);
+static void TopHSMDispatchNoEvent(uint16_t iteration);
+static void TapeFrameProcessSteady(uint16_t iteration);
+static void TapeFrameProcessToggle(uint16_t iteration);
+static void AdjustPWMKernel(uint16_t iteration);
+static void MotorsForward(uint16_t iteration);
+static void BotDriveCurve(uint16_t iteration);
+static void BotDriveRepeat(uint16_t iteration);
+static void TracePrintf(uint16_t iteration);
+static void SerialTxPrintf(uint16_t iteration);
+static void ReadyClz(uint16_t iteration);
+static void ReadyPortable(uint16_t iteration);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static volatile uint16_t sink;  // keeps results from being optimised away
+
+static ES_Event queue[BENCH_QUEUE_SIZE];
+static TapeFrame_t frame;
+static const uint16_t tape_masks[NUM_TAPE_SENSORS] = TAPE_SENSOR_MASK_LIST;
+
+static const Kernel_t kernels[] = {
+    {"event_queue_fifo", BENCH_ITERATIONS, EventQueueFIFO},
+    {"event_pool_alloc_release", BENCH_ITERATIONS, EventPoolAllocRelease},
+    {"top_hsm_dispatch_unhandled", BENCH_ITERATIONS, TopHSMDispatchUnhandled},
+    {"top_hsm_dispatch_no_event", BENCH_ITERATIONS, TopHSMDispatchNoEvent},
+    {"tape_frame_process_steady", BENCH_ITERATIONS, TapeFrameProcessSteady},
+    {"tape_frame_process_toggle", BENCH_ITERATIONS, TapeFrameProcessToggle},
+    {"adjust_pwm", BENCH_ITERATIONS, AdjustPWMKernel},
+    {"motors_forward", BENCH_ITERATIONS, MotorsForward},
+    {"bot_drive_curve", BENCH_ITERATIONS, BotDriveCurve},
+    {"bot_drive_repeat", BENCH_ITERATIONS, BotDriveRepeat},
+    {"trace_printf", TRACE_ITERATIONS, TracePrintf},
+    {"serial_tx_printf", TRACE_ITERATIONS, SerialTxPrintf},
+    {"ready_highest_clz_32", BENCH_ITERATIONS, ReadyClz},
+    {"ready_highest_portable_32", BENCH_ITERATIONS, ReadyPortable},
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void main(void) {
+    uint8_t i;
+
+    BOARD_Init();
+    AD_Init();
+    AD_AddPins(AD_PIN_LIST);
+    InitMotors();
+    SetupKernels();
+
+    WaitForTransmit();
+    printf("\r\n#BENCH begin %d target %ld", NUM_TAPE_SENSORS, CORE_TIMER_HZ);
+    for (i = 0; i < sizeof (kernels) / sizeof (kernels[0]); i++) {
+        RunKernel(&kernels[i]);
+    }
+    printf("\r\n#BENCH end\r\n");
+    LeftMotorHalt();
+    RightMotorHalt();
+    for (;;)
+        ;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// Each iteration is timed on its own so the serial wait of the trace kernel
+// stays out of the count, the two core timer reads are a few ticks.
+static void RunKernel(const Kernel_t *kernel) {
+    uint32_t start, ticks = 0;
+    uint16_t i;
+
+    WaitForTransmit();
+    for (i = 0; i < kernel->iterations; i++) {
+        if (kernel->run == TracePrintf) WaitForTransmit();
+        start = _CP0_GET_COUNT();
+        kernel->run(i);
+        ticks += _CP0_GET_COUNT() - start;
+    }
+    WaitForTransmit();
+    printf("\r\nT %s %u %lu", kernel->name, kernel->iterations, (unsigned long) ticks);
+}
+
+// Brings the framework up far enough for TopHSM to be sitting in its first
+// real state. The queues are never serviced, posts that find them full fail
+// quietly.
+static void SetupKernels(void) {
+    ES_InitQueue(queue, BENCH_QUEUE_SIZE);
+    TapeFrame_Init(&frame, tape_masks, BLACK_MEAN, WHITE_MEAN);
+    ES_Initialize();
+    RunTopHSM(INIT_EVENT);
+}
+
+static void WaitForTransmit(void) {
+    while (!IsTransmitEmpty());
+}
+
+static void EventQueueFIFO(uint16_t iteration) {
+    ES_Event ThisEvent = {TW_PROX_FOUND, iteration};
+    ES_EnQueueFIFO(queue, ThisEvent);
+    ES_DeQueue(queue, &ThisEvent);
+    sink = ThisEvent.EventParam;
+}
+
+static void EventPoolAllocRelease(uint16_t iteration) {
+    uint16_t handle = EventPool_Alloc();
+    EventPool_Release(handle);
+    sink = handle;
+}
+
+// an event no state handles walks the whole active chain
+static void TopHSMDispatchUnhandled(uint16_t iteration) {
+    ES_Event ThisEvent = {TW_PROX_FOUND, iteration};
+    sink = RunTopHSM(ThisEvent).EventType;
+}
+
+static void TopHSMDispatchNoEvent(uint16_t iteration) {
+    ES_Event ThisEvent = {ES_NO_EVENT, 0};
+    sink = RunTopHSM(ThisEvent).EventType;
+}
+
+static void TapeFrameProcessSteady(uint16_t iteration) {
+    sink = TapeFrame_Process(&frame);
+}
+
+static void TapeFrameProcessToggle(uint16_t iteration) {
+    uint16_t on = (iteration & 0x01) ? 800 : 200;
+    uint8_t i;
+    for (i = 0; i < NUM_TAPE_SENSORS; i++) {
+        frame.off[i] = 900;
+        frame.on[i] = on;
+    }
+    sink = TapeFrame_Process(&frame);
+}
+
+static void AdjustPWMKernel(uint16_t iteration) {
+    sink = AdjustPWM(iteration % 1000);
+}
+
+// both wheels written, what BotDrive() comes down to when the command moves
+static void MotorsForward(uint16_t iteration) {
+    LeftMotorMoveForward(300);
+    RightMotorMoveForward(300);
+}
+
+// a controller sweeping the curvature every frame, past saturation at the ends
+static void BotDriveCurve(uint16_t iteration) {
+    BotDrive(600, (int) (iteration % 1000) - 500);
+}
+
+// the same command again, nothing to write
+static void BotDriveRepeat(uint16_t iteration) {
+    BotDrive(300, 100);
+}
+
+static void TracePrintf(uint16_t iteration) {
+    printf("\r\n# trace %u %lu", iteration, (unsigned long) ES_Timer_GetTime());
+}
+
+// the same line into the SerialTx ring, nothing drains it here and the 50
+// lines fit
+static void SerialTxPrintf(uint16_t iteration) {
+    SerialTx_Printf("\r\n# trace %u %lu", iteration, (unsigned long) ES_Timer_GetTime());
+}
+
+// one bit walking up through all 32 priorities
+static void ReadyClz(uint16_t iteration) {
+    sink = ReadySet_Highest((ReadySet_t) 1 << (iteration & (READY_SET_SIZE - 1)));
+}
+
+static void ReadyPortable(uint16_t iteration) {
+    sink = ReadySet_HighestPortable((ReadySet_t) 1 << (iteration & (READY_SET_SIZE - 1)));
+}
+
+#endif
@@ -33,7 +33,9 @@
 #include "TopHSM.h"
 #include "DepositBallsSM.h"
 #include "RC_Servo.h"
+#include "timers.h"
 #include "PinsMaster.h"
+#include "StateStats.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -58,7 +60,7 @@ typedef enum {
     testState,
 } DepositBallsSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"OpenState0",
 	"CloseState0",
@@ -83,6 +85,7 @@ static const char *StateNames[] = {
  * The type of state variable should match that of enum in header file. */
 
 static DepositBallsSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
+STATE_STATS(Stats, "DepositBallsSM", StateNames);
 static uint8_t MyPriority;
 
 
@@ -106,6 +109,7 @@ uint8_t InitDepositBallsSM(void) {
     TIMERS_Init();
 
     CurrentState = InitPSubState;
+    StateStats_Enter(&Stats, CurrentState);
     returnEvent = RunDepositBallsSM(INIT_EVENT);
     if (returnEvent.EventType == ES_NO_EVENT) {
         return TRUE;
@@ -138,6 +142,10 @@ ES_Event RunDepositBallsSM(ES_Event ThisEvent) {
 
     ES_Tattle(); // trace call stack
 
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
+    }
+
     switch (CurrentState) {
         case InitPSubState: // If current state is initial Psedudo State
             if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
@@ -274,6 +282,7 @@ ES_Event RunDepositBallsSM(ES_Event ThisEvent) {
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
         RunDepositBallsSM(EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
         CurrentState = nextState;
         RunDepositBallsSM(ENTRY_EVENT); // <- rename to your own Run function
     }
@@ -2,14 +2,9 @@
  Module
      ES_Configure.h
  Description
-     This file contains macro definitions that are edited by the user to
-     adapt the Events and Services framework to a particular application.
- Notes
-     
- History
- When           Who     What/Why
- -------------- ---     --------
- 01/15/12 10:03 jec      started coding
+     GENERATED FILE - DO NOT EDIT.
+     Produced by ES_Gen.py from ES_Spec.json. Edit the spec and rebuild (the
+     generator runs as the project pre-build step).
  *****************************************************************************/
 
 #ifndef CONFIGURE_H
@@ -36,15 +31,16 @@
 
 /****************************************************************************/
 typedef enum {
-    ES_NO_EVENT, ES_ERROR, /* used to indicate an error from the service */
+    ES_NO_EVENT,
+    ES_ERROR, /* used to indicate an error from the service */
     ES_INIT, /* used to transition from initial pseudo-state */
-    ES_ENTRY, /* used to enter a state*/
-    ES_EXIT, /* used to exit a state*/
-    ES_KEYINPUT, /* used to signify a key has been pressed*/
-    ES_LISTEVENTS, /* used to list events in keyboard input, does not get posted to fsm*/
+    ES_ENTRY, /* used to enter a state */
+    ES_EXIT, /* used to exit a state */
+    ES_KEYINPUT, /* used to signify a key has been pressed */
+    ES_LISTEVENTS, /* used to list events in keyboard input, does not get posted to fsm */
     ES_TIMEOUT, /* signals that the timer has expired */
     ES_TIMERACTIVE, /* signals that a timer has become active */
-    ES_TIMERSTOPPED, /* signals that a timer has stopped*/
+    ES_TIMERSTOPPED, /* signals that a timer has stopped */
     /* User-defined events start here */
     // BATTERY
     BATTERY_CONNECTED,
@@ -64,50 +60,30 @@ typedef enum {
     TRACK_WIRE_LOST,
     TW_PROX_FOUND,
     TW_PROX_LOST,
-    //BEACON DETECTION
+    // BEACON DETECTION
     BEACON_LOST,
     BEACON_FOUND,
     // BUMP DETECTION
     BUMPER_TRIPPED,
     BUMP_RESOLVED,
-    NUMBEROFEVENTS,
     // AMMO PLUNGER
     AMMO_PLUNGER_LOST,
+    // SUPERVISOR
+    STATE_STALLED,
+    // BOOT
+    SENSORS_WARM,
+    // ADC
+    AD_FRAME_READY,
+    // SERVICE HOST
+    SERVICES_READY,
+    // SENSOR TIER
+    TAPE_PAIR_READY,
+    TAPE_CALIBRATION_DONE,
+    NUMBEROFEVENTS, /* must stay last, sizes the name table */
 } ES_EventTyp_t;
 
-static const char *EventNames[] = {
-	"ES_NO_EVENT",
-	"ES_ERROR",
-	"ES_INIT",
-	"ES_ENTRY",
-	"ES_EXIT",
-	"ES_KEYINPUT",
-	"ES_LISTEVENTS",
-	"ES_TIMEOUT",
-	"ES_TIMERACTIVE",
-	"ES_TIMERSTOPPED",
-	"BATTERY_CONNECTED",
-	"BATTERY_DISCONNECTED",
-	"INIT_DONE",
-	"BALLS_LOADED",
-	"BALLS_EMPTY",
-	"BALL_DROPPED",
-	"WHITE_TAPE_DETECTED",
-	"BLACK_TAPE_DETECTED",
-	"TAPE_SENSOR_TRIPPED",
-	"TRACK_WIRE_FOUND",
-	"TRACK_WIRE_LOST",
-	"TW_PROX_FOUND",
-	"TW_PROX_LOST",
-	"BEACON_LOST",
-	"BEACON_FOUND",
-	"BUMPER_TRIPPED",
-	"BUMP_RESOLVED",
-	"NUMBEROFEVENTS",
-	"AMMO_PLUNGER_LOST",
-};
-
-
+// string form of ES_EventTyp_t, defined in ES_Names.c and held in flash
+extern const char * const EventNames[NUMBEROFEVENTS];
 
 
 /****************************************************************************/
@@ -116,7 +92,7 @@ static const char *EventNames[] = {
 
 /****************************************************************************/
 // This is the list of event checking functions
-#define EVENT_CHECK_LIST DetectBeacon
+#define EVENT_CHECK_LIST DetectBeacon, CheckStatsRequest, CheckADFrame, CheckSensorTier, CheckStalls, CheckSerialTx, CheckIdle
 
 
 /****************************************************************************/
@@ -136,7 +112,7 @@ static const char *EventNames[] = {
 #define TIMER9_RESP_FUNC PostTopHSM
 #define TIMER10_RESP_FUNC PostTopHSM
 #define TIMER11_RESP_FUNC PostTopHSM
-#define TIMER12_RESP_FUNC TIMER_UNUSED
+#define TIMER12_RESP_FUNC PostWheelCalService
 #define TIMER13_RESP_FUNC TIMER_UNUSED
 #define TIMER14_RESP_FUNC TIMER_UNUSED
 #define TIMER15_RESP_FUNC TIMER_UNUSED
@@ -144,11 +120,9 @@ static const char *EventNames[] = {
 
 /****************************************************************************/
 // Give the timer numbers symbolc names to make it easier to move them
-// to different timers if the need arises. Keep these definitons close to the
-// definitions for the response functions to make it easire to check that
-// the timer number matches where the timer event will be routed
+// to different timers if the need arises.
 
-#define GENERIC_NAMED_TIMER 0 /*make sure this is enabled above and posting to the correct state machine*/
+#define GENERIC_NAMED_TIMER 0
 #define TAPE_SENSOR_TIMER 1
 #define BUMPER_TIMER 2
 #define BUMP_RES_TIMER 3
@@ -160,162 +134,83 @@ static const char *EventNames[] = {
 #define DEPOSIT_TIMER 9
 #define EX_RADAR_TIMER 10
 #define TAPE_FOLLOW_TIMER 11
+#define WHEEL_CAL_TIMER 12
 
 /****************************************************************************/
 // The maximum number of services sets an upper bound on the number of 
-// services that the framework will handle. Reasonable values are 8 and 16
-// HOWEVER: at this time only a value of 8 is supported.
+// services that the framework will handle.
 #define MAX_NUM_SERVICES 8
 
 /****************************************************************************/
 // This macro determines that nuber of services that are *actually* used in
 // a particular application. It will vary in value from 1 to MAX_NUM_SERVICES
-#define NUM_SERVICES 5
+#define NUM_SERVICES 6
 
 /****************************************************************************/
-// These are the definitions for Service 0, the lowest priority service
-// every Events and Services application must have a Service 0. Further 
-// services are added in numeric sequence (1,2,3,...) with increasing 
-// priorities
-// the header file with the public fuction prototypes
+// These are the definitions for Service 0
 #define SERV_0_HEADER "ES_KeyboardInput.h"
-// the name of the Init function
 #define SERV_0_INIT InitKeyboardInput
-// the name of the run function
 #define SERV_0_RUN RunKeyboardInput
-// How big should this service's Queue be?
 #define SERV_0_QUEUE_SIZE 9
 
 /****************************************************************************/
 // These are the definitions for Service 1
 #if NUM_SERVICES > 1
-// the header file with the public fuction prototypes
 #define SERV_1_HEADER "TapeSensorService.h"
-// the name of the Init function
 #define SERV_1_INIT InitTapeSensorService
-// the name of the run function
 #define SERV_1_RUN RunTapeSensorService
-// How big should this services Queue be?
 #define SERV_1_QUEUE_SIZE 3
 #endif
 
+/****************************************************************************/
 // These are the definitions for Service 2
 #if NUM_SERVICES > 2
-// the header file with the public fuction prototypes
 #define SERV_2_HEADER "TopHSM.h"
-// the name of the Init function
 #define SERV_2_INIT InitTopHSM
-// the name of the run function
 #define SERV_2_RUN RunTopHSM
-// How big should this services Queue be?
-#define SERV_2_QUEUE_SIZE 3
+#define SERV_2_QUEUE_SIZE 8
 #endif
 
-
-
 /****************************************************************************/
 // These are the definitions for Service 3
 #if NUM_SERVICES > 3
-// the header file with the public fuction prototypes
 #define SERV_3_HEADER "BumperService.h"
-// the name of the Init function
 #define SERV_3_INIT InitBumperService
-// the name of the run function
 #define SERV_3_RUN RunBumperService
-// How big should this services Queue be?
 #define SERV_3_QUEUE_SIZE 3
 #endif
 
 /****************************************************************************/
 // These are the definitions for Service 4
 #if NUM_SERVICES > 4
-// the header file with the public fuction prototypes
 #define SERV_4_HEADER "TrackWireService.h"
-// the name of the Init function
 #define SERV_4_INIT InitTrackWireService
-// the name of the run function
 #define SERV_4_RUN RunTrackWireService
-// How big should this services Queue be?
 #define SERV_4_QUEUE_SIZE 3
 #endif
 
 /****************************************************************************/
 // These are the definitions for Service 5
 #if NUM_SERVICES > 5
-// the header file with the public fuction prototypes
-#define SERV_5_HEADER "TestService.h"
-// the name of the Init function
-#define SERV_5_INIT TestServiceInit
-// the name of the run function
-#define SERV_5_RUN TestServiceRun
-// How big should this services Queue be?
+#define SERV_5_HEADER "ServiceHost.h"
+#define SERV_5_INIT InitServiceHost
+#define SERV_5_RUN RunServiceHost
 #define SERV_5_QUEUE_SIZE 3
 #endif
 
 /****************************************************************************/
-// These are the definitions for Service 6
-#if NUM_SERVICES > 6
-// the header file with the public fuction prototypes
-#define SERV_6_HEADER "TestService.h"
-// the name of the Init function
-#define SERV_6_INIT TestServiceInit
-// the name of the run function
-#define SERV_6_RUN TestServiceRun
-// How big should this services Queue be?
-#define SERV_6_QUEUE_SIZE 3
-#endif
-
-/****************************************************************************/
-// These are the definitions for Service 7
-#if NUM_SERVICES > 7
-// the header file with the public fuction prototypes
-#define SERV_7_HEADER "TestService.h"
-// the name of the Init function
-#define SERV_7_INIT TestServiceInit
-// the name of the run function
-#define SERV_7_RUN TestServiceRun
-// How big should this services Queue be?
-#define SERV_7_QUEUE_SIZE 3
-#endif
+// Services run by ServiceHost inside one framework service, see ES_Hosted.c
+#define NUM_HOSTED_SERVICES 1
 
 /****************************************************************************/
 // the name of the posting function that you want executed when a new 
 // keystroke is detected.
-// The default initialization distributes keystrokes to all state machines
 #define POST_KEY_FUNC ES_PostAll
 
-
-
 /****************************************************************************/
 // These are the definitions for the Distribution lists. Each definition
 // should be a comma seperated list of post functions to indicate which
 // services are on that distribution list.
 #define NUM_DIST_LISTS 0
-#if NUM_DIST_LISTS > 0 
-#define DIST_LIST0 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 1 
-#define DIST_LIST1 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 2 
-#define DIST_LIST2 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 3 
-#define DIST_LIST3 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 4 
-#define DIST_LIST4 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 5 
-#define DIST_LIST5 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 6 
-#define DIST_LIST6 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 7 
-#define DIST_LIST7 PostTemplateFSM
-#endif
-
-
 
-#endif /* CONFIGURE_H */
\ No newline at end of file
+#endif /* CONFIGURE_H */
@@ -0,0 +1,322 @@
+import sys
+import os
+import re
+import json
+import logging
+
+# ES_Gen.py
+#
+# Generates ES_Configure.h, ES_Names.c and ES_Hosted.c/.h from ES_Spec.json, and
+# refreshes the StateNames[] table of every state machine listed in the spec.
+# This replaces Enum_To_String.py as the MPLAB pre-build step: the event enum,
+# the event name table, the timer routing and the service list all come from
+# one place, so they can no longer drift apart.
+#
+# Services past the framework's max_services go under "hosted_services" and
+# run inside ServiceHost (see ServiceHost.h), which must then be one of the
+# framework services. ES_Hosted.c holds their table and queues, ES_Hosted.h
+# includes their headers (ServiceHost.h includes it, so their Post functions
+# are declared wherever the framework services' are, timers included).
+#
+# Name tables are emitted as "const char * const" so that both the strings and
+# the pointer array land in flash (.rodata) instead of being copied into RAM by
+# every translation unit that includes ES_Configure.h.
+#
+# usage: python ES_Gen.py [spec]     (run from the project directory)
+
+SpecName = 'ES_Spec.json'
+ConfigureName = 'ES_Configure.h'
+NamesName = 'ES_Names.c'
+HostedName = 'ES_Hosted.c'
+HostedHeaderName = 'ES_Hosted.h'
+
+MaxTimers = 16
+MaxHostedServices = 32   # one ReadySet_t
+HostRun = 'RunServiceHost'
+
+# framework events always occupy the lowest entries of the enum
+UniversalEvents = [
+	('ES_NO_EVENT', None),
+	('ES_ERROR', 'used to indicate an error from the service'),
+	('ES_INIT', 'used to transition from initial pseudo-state'),
+	('ES_ENTRY', 'used to enter a state'),
+	('ES_EXIT', 'used to exit a state'),
+	('ES_KEYINPUT', 'used to signify a key has been pressed'),
+	('ES_LISTEVENTS', 'used to list events in keyboard input, does not get posted to fsm'),
+	('ES_TIMEOUT', 'signals that the timer has expired'),
+	('ES_TIMERACTIVE', 'signals that a timer has become active'),
+	('ES_TIMERSTOPPED', 'signals that a timer has stopped'),
+]
+
+# the sentinel is appended by the generator, it must never appear in the spec
+EventSentinel = 'NUMBEROFEVENTS'
+
+Banner = '''/****************************************************************************
+ Module
+     %s
+ Description
+     GENERATED FILE - DO NOT EDIT.
+     Produced by ES_Gen.py from ES_Spec.json. Edit the spec and rebuild (the
+     generator runs as the project pre-build step).
+ *****************************************************************************/
+'''
+
+Rule = '/****************************************************************************/\n'
+
+
+class SpecError(Exception):
+	pass
+
+
+class ESGenerator(object):
+
+	def __init__(self, specName):
+		self.specName = specName
+		with open(specName, 'r') as f:
+			self.spec = json.load(f)
+		self.events = []
+
+	# checks the spec for the mistakes that used to slip into ES_Configure.h
+	def validate(self):
+		seen = set()
+		for name, comment in UniversalEvents:
+			seen.add(name)
+		for group in self.spec['events']:
+			for name in group['names']:
+				if name == EventSentinel:
+					raise SpecError(EventSentinel + ' is added by the generator, remove it from the spec')
+				if name in seen:
+					raise SpecError('duplicate event ' + name)
+				seen.add(name)
+				self.events.append(name)
+
+		timerNames = set()
+		timerNums = set()
+		for timer in self.spec['timers']:
+			if timer['num'] < 0 or timer['num'] >= MaxTimers:
+				raise SpecError('timer %s out of range' % timer['name'])
+			if timer['num'] in timerNums or timer['name'] in timerNames:
+				raise SpecError('timer %s defined twice' % timer['name'])
+			timerNums.add(timer['num'])
+			timerNames.add(timer['name'])
+
+		services = self.spec['services']
+		if len(services) == 0:
+			raise SpecError('service 0 is required')
+		if len(services) > self.spec['max_services']:
+			raise SpecError('%d services exceed max_services (%d)' % (len(services), self.spec['max_services']))
+		hosted = self.spec['hosted_services']
+		if len(hosted) > MaxHostedServices:
+			raise SpecError('%d hosted services exceed %d' % (len(hosted), MaxHostedServices))
+		if hosted and HostRun not in [service['run'] for service in services]:
+			raise SpecError('hosted services need ServiceHost in the service list')
+		for service in services + hosted:
+			if service['queue_size'] < 1 or service['queue_size'] > 255:
+				raise SpecError('bad queue size for ' + service['run'])
+
+	def buildConfigure(self):
+		spec = self.spec
+		out = [Banner % ConfigureName, '\n#ifndef CONFIGURE_H\n#define CONFIGURE_H\n\n']
+
+		opts = spec['options']
+		out.append('\n//defines for keyboard input\n')
+		out.append(('' if opts['USE_KEYBOARD_INPUT'] else '//') + '#define USE_KEYBOARD_INPUT\n')
+		out.append('//What State machine are we testing\n')
+		out.append(('' if opts['USE_KEYBOARD_INPUT'] else '//') +
+				'#define POSTFUNCTION_FOR_KEYBOARD_INPUT ' + opts['POSTFUNCTION_FOR_KEYBOARD_INPUT'] + '\n')
+		out.append('\n//define to use adjusted speeds\n')
+		out.append(('' if opts['USE_BAT_ADJUSTED_SPEED'] else '//') + '#define USE_BAT_ADJUSTED_SPEED\n')
+		out.append('\n//define for TattleTale\n')
+		out.append(('' if opts['USE_TATTLETALE'] else '//') + '#define USE_TATTLETALE\n')
+		out.append('\n//uncomment to supress the entry and exit events\n')
+		out.append(('' if opts['SUPPRESS_EXIT_ENTRY_IN_TATTLE'] else '//') + '#define SUPPRESS_EXIT_ENTRY_IN_TATTLE\n')
+
+		out.append('\n' + Rule)
+		out.append('// Name/define the events of interest\n')
+		out.append('// Universal events occupy the lowest entries, followed by user-defined events\n\n')
+		out.append(Rule)
+		out.append('typedef enum {\n')
+		for name, comment in UniversalEvents:
+			out.append('    %s,%s\n' % (name, '' if comment is None else ' /* %s */' % comment))
+		out.append('    /* User-defined events start here */\n')
+		for group in spec['events']:
+			out.append('    // %s\n' % group['group'])
+			for name in group['names']:
+				out.append('    %s,\n' % name)
+		out.append('    %s, /* must stay last, sizes the name table */\n' % EventSentinel)
+		out.append('} ES_EventTyp_t;\n\n')
+		out.append('// string form of ES_EventTyp_t, defined in %s and held in flash\n' % NamesName)
+		out.append('extern const char * const EventNames[%s];\n\n' % EventSentinel)
+
+		out.append('\n' + Rule)
+		out.append('// This are the name of the Event checking function header file.\n')
+		out.append('#define EVENT_CHECK_HEADER "%s"\n\n' % spec['event_checkers']['header'])
+		out.append(Rule)
+		out.append('// This is the list of event checking functions\n')
+		out.append('#define EVENT_CHECK_LIST %s\n\n' % ', '.join(spec['event_checkers']['list']))
+
+		timers = dict((t['num'], t) for t in spec['timers'])
+		out.append('\n' + Rule)
+		out.append('// These are the definitions for the post functions to be executed when the\n')
+		out.append('// corresponding timer expires. All 16 must be defined. If you are not using\n')
+		out.append('// a timers, then you can use TIMER_UNUSED\n')
+		out.append('#define TIMER_UNUSED ((pPostFunc)0)\n')
+		for num in range(MaxTimers):
+			post = 'TIMER_UNUSED'
+			if num in timers and timers[num]['post'] is not None:
+				post = timers[num]['post']
+			out.append('#define TIMER%d_RESP_FUNC %s\n' % (num, post))
+
+		out.append('\n\n' + Rule)
+		out.append('// Give the timer numbers symbolc names to make it easier to move them\n')
+		out.append('// to different timers if the need arises.\n\n')
+		for timer in sorted(spec['timers'], key=lambda t: t['num']):
+			out.append('#define %s %d\n' % (timer['name'], timer['num']))
+
+		out.append('\n' + Rule)
+		out.append('// The maximum number of services sets an upper bound on the number of \n')
+		out.append('// services that the framework will handle.\n')
+		out.append('#define MAX_NUM_SERVICES %d\n\n' % spec['max_services'])
+		out.append(Rule)
+		out.append('// This macro determines that nuber of services that are *actually* used in\n')
+		out.append('// a particular application. It will vary in value from 1 to MAX_NUM_SERVICES\n')
+		out.append('#define NUM_SERVICES %d\n\n' % len(spec['services']))
+
+		for i, service in enumerate(spec['services']):
+			out.append(Rule)
+			out.append('// These are the definitions for Service %d\n' % i)
+			if i > 0:
+				out.append('#if NUM_SERVICES > %d\n' % i)
+			out.append('#define SERV_%d_HEADER "%s"\n' % (i, service['header']))
+			out.append('#define SERV_%d_INIT %s\n' % (i, service['init']))
+			out.append('#define SERV_%d_RUN %s\n' % (i, service['run']))
+			out.append('#define SERV_%d_QUEUE_SIZE %d\n' % (i, service['queue_size']))
+			if i > 0:
+				out.append('#endif\n')
+			out.append('\n')
+
+		out.append(Rule)
+		out.append('// Services run by ServiceHost inside one framework service, see ES_Hosted.c\n')
+		out.append('#define NUM_HOSTED_SERVICES %d\n\n' % len(spec['hosted_services']))
+
+		out.append(Rule)
+		out.append('// the name of the posting function that you want executed when a new \n')
+		out.append('// keystroke is detected.\n')
+		out.append('#define POST_KEY_FUNC %s\n\n' % spec['post_key_func'])
+
+		out.append(Rule)
+		out.append('// These are the definitions for the Distribution lists. Each definition\n')
+		out.append('// should be a comma seperated list of post functions to indicate which\n')
+		out.append('// services are on that distribution list.\n')
+		out.append('#define NUM_DIST_LISTS %d\n' % len(spec['dist_lists']))
+		for i, distList in enumerate(spec['dist_lists']):
+			out.append('#define DIST_LIST%d %s\n' % (i, ', '.join(distList)))
+
+		out.append('\n#endif /* CONFIGURE_H */\n')
+		return ''.join(out)
+
+	def buildNames(self):
+		out = [Banner % NamesName, '\n#include "ES_Configure.h"\n\n']
+		out.append('const char * const EventNames[%s] = {\n' % EventSentinel)
+		for name, comment in UniversalEvents:
+			out.append('\t"%s",\n' % name)
+		for name in self.events:
+			out.append('\t"%s",\n' % name)
+		out.append('};\n')
+		return ''.join(out)
+
+	def buildHosted(self):
+		hosted = self.spec['hosted_services']
+		out = [Banner % HostedName, '\n#include "ES_Configure.h"\n']
+		if not hosted:
+			out.append('\n// no hosted services, ServiceHost.c compiles to nothing\n')
+			return ''.join(out)
+		out.append('#include "ES_Framework.h"\n#include "ServiceHost.h"\n')
+		for service in hosted:
+			out.append('#include "%s"\n' % service['header'])
+		out.append('\n')
+		for i, service in enumerate(hosted):
+			out.append('static ES_Event Queue%d[%d];\n' % (i, service['queue_size']))
+		out.append('\n// index is priority, the last one runs first\n')
+		out.append('HostedService_t HostedServices[NUM_HOSTED_SERVICES] = {\n')
+		for i, service in enumerate(hosted):
+			out.append('\t{%s, %s, Queue%d, %d, 0, 0},\n' % (service['init'], service['run'], i, service['queue_size']))
+		out.append('};\n')
+		return ''.join(out)
+
+	def buildHostedHeader(self):
+		hosted = self.spec['hosted_services']
+		out = [Banner % HostedHeaderName, '\n#ifndef ES_HOSTED_H\n#define ES_HOSTED_H\n\n']
+		if not hosted:
+			out.append('// no hosted services\n')
+		for service in hosted:
+			out.append('#include "%s"\n' % service['header'])
+		out.append('\n#endif /* ES_HOSTED_H */\n')
+		return ''.join(out)
+
+	def generate(self):
+		self.validate()
+		writeIfChanged(ConfigureName, self.buildConfigure())
+		writeIfChanged(NamesName, self.buildNames())
+		writeIfChanged(HostedName, self.buildHosted())
+		writeIfChanged(HostedHeaderName, self.buildHostedHeader())
+		for fileName in self.spec['state_machines']:
+			if os.path.exists(fileName):
+				StateNameTable(fileName).refresh()
+			else:
+				logging.warning('state machine %s listed in the spec does not exist' % fileName)
+
+
+# rebuilds the StateNames[] table that follows the state enum of a machine
+class StateNameTable(object):
+	enumRegEx = re.compile(r"typedef[ ]+enum[ ]*\{(?P<enum_names>[^\}]+)\}[ ]+[A-Za-z0-9_]*[sS]tate_t;", re.MULTILINE)
+	enumNameRegEx = re.compile(r"[\t ]*(?P<Names>[a-zA-Z0-9_]+)[ ]*,")
+	tableRegEx = re.compile(r"\nstatic const char \*[ ]*(const[ ]+)?StateNames\[\] = \{\n[^\}]*\n\};\n\n", re.MULTILINE)
+
+	def __init__(self, fileName):
+		self.fileName = fileName
+
+	def refresh(self):
+		with open(self.fileName, 'r') as f:
+			contents = f.read()
+		results = self.enumRegEx.search(contents)
+		if results is None:
+			logging.warning('no state enum found in ' + self.fileName)
+			return
+		names = []
+		for line in results.group('enum_names').split('\n'):
+			commentStart = line.find('/*')
+			if commentStart == -1:
+				commentStart = line.find('//')
+				if commentStart == -1:
+					commentStart = len(line)
+			names.extend(self.enumNameRegEx.findall(line[:commentStart]))
+		table = '\nstatic const char * const StateNames[] = {\n'
+		table += '\n'.join(['\t"' + x + '",' for x in names])
+		table += '\n};\n\n'
+		contents = self.tableRegEx.sub('', contents)
+		endOfEnum = self.enumRegEx.search(contents).end() + 1
+		contents = contents[:endOfEnum] + table + contents[endOfEnum:]
+		writeIfChanged(self.fileName, contents)
+
+
+def writeIfChanged(fileName, contents):
+	old = None
+	if os.path.exists(fileName):
+		with open(fileName, 'r') as f:
+			old = f.read()
+	if old != contents:
+		with open(fileName, 'w') as f:
+			f.write(contents)
+		logging.info('regenerated ' + fileName)
+
+
+if __name__ == '__main__':
+	logging.basicConfig(level=logging.INFO, format='[%(levelname)s]%(asctime)s: %(message)s',
+			stream=sys.stdout)
+	specName = sys.argv[1] if len(sys.argv) > 1 else SpecName
+	try:
+		ESGenerator(specName).generate()
+	except SpecError as e:
+		logging.error(str(e))
+		sys.exit(1)
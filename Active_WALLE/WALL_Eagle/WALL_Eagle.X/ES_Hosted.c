@@ -0,0 +1,20 @@
+/****************************************************************************
+ Module
+     ES_Hosted.c
+ Description
+     GENERATED FILE - DO NOT EDIT.
+     Produced by ES_Gen.py from ES_Spec.json. Edit the spec and rebuild (the
+     generator runs as the project pre-build step).
+ *****************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ServiceHost.h"
+#include "WheelCalService.h"
+
+static ES_Event Queue0[3];
+
+// index is priority, the last one runs first
+HostedService_t HostedServices[NUM_HOSTED_SERVICES] = {
+	{InitWheelCalService, RunWheelCalService, Queue0, 3, 0, 0},
+};
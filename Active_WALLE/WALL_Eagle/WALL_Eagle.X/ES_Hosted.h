@@ -0,0 +1,15 @@
+/****************************************************************************
+ Module
+     ES_Hosted.h
+ Description
+     GENERATED FILE - DO NOT EDIT.
+     Produced by ES_Gen.py from ES_Spec.json. Edit the spec and rebuild (the
+     generator runs as the project pre-build step).
+ *****************************************************************************/
+
+#ifndef ES_HOSTED_H
+#define ES_HOSTED_H
+
+#include "WheelCalService.h"
+
+#endif /* ES_HOSTED_H */
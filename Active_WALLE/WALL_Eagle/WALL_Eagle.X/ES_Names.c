@@ -0,0 +1,47 @@
+/****************************************************************************
+ Module
+     ES_Names.c
+ Description
+     GENERATED FILE - DO NOT EDIT.
+     Produced by ES_Gen.py from ES_Spec.json. Edit the spec and rebuild (the
+     generator runs as the project pre-build step).
+ *****************************************************************************/
+
+#include "ES_Configure.h"
+
+const char * const EventNames[NUMBEROFEVENTS] = {
+	"ES_NO_EVENT",
+	"ES_ERROR",
+	"ES_INIT",
+	"ES_ENTRY",
+	"ES_EXIT",
+	"ES_KEYINPUT",
+	"ES_LISTEVENTS",
+	"ES_TIMEOUT",
+	"ES_TIMERACTIVE",
+	"ES_TIMERSTOPPED",
+	"BATTERY_CONNECTED",
+	"BATTERY_DISCONNECTED",
+	"INIT_DONE",
+	"BALLS_LOADED",
+	"BALLS_EMPTY",
+	"BALL_DROPPED",
+	"WHITE_TAPE_DETECTED",
+	"BLACK_TAPE_DETECTED",
+	"TAPE_SENSOR_TRIPPED",
+	"TRACK_WIRE_FOUND",
+	"TRACK_WIRE_LOST",
+	"TW_PROX_FOUND",
+	"TW_PROX_LOST",
+	"BEACON_LOST",
+	"BEACON_FOUND",
+	"BUMPER_TRIPPED",
+	"BUMP_RESOLVED",
+	"AMMO_PLUNGER_LOST",
+	"STATE_STALLED",
+	"SENSORS_WARM",
+	"AD_FRAME_READY",
+	"SERVICES_READY",
+	"TAPE_PAIR_READY",
+	"TAPE_CALIBRATION_DONE",
+};
@@ -29,9 +29,22 @@
 #include "ES_Configure.h"
 #include "EventChecker.h"
 #include "ES_Events.h"
+#include "ES_Timers.h"
 #include "serial.h"
 #include "AD.h"
 #include "stdio.h"
+#include "WorldState.h"
+#include "StateStats.h"
+#include "ADFrame.h"
+#include "SensorRate.h"
+#include "EventMailbox.h"
+#include "EventLanes.h"
+#include "TopHSM.h"
+#include "Idle.h"
+#include "SerialTx.h"
+#include "SensorTier.h"
+#include "HSMSupervisor.h"
+#include "BootProfile.h"
 
 
 /*******************************************************************************
@@ -43,6 +56,18 @@
 #define TW_HIGH_THRESHOLD 900
 #define TW_LOW_THRESHOLD 600
 
+#define STATS_CHECK_PERIOD 50 // ms, a key press does not need to be seen sooner
+
+// returns FALSE from the checker until period ms have passed since it last
+// got through, so a checker that polls runs at its own rate instead of on
+// every pass of ES_Run
+#define RunEvery(period) do { \
+        static uint32_t last_run; \
+        uint32_t now = ES_Timer_GetTime(); \
+        if (now - last_run < (period)) return FALSE; \
+        last_run = now; \
+    } while (0)
+
 /*******************************************************************************
  * EVENTCHECKER_TEST SPECIFIC CODE                                                             *
  ******************************************************************************/
@@ -93,8 +118,17 @@ uint8_t DetectBeacon(void) {
     static ES_EventTyp_t lastEvent = BEACON_LOST;
     ES_EventTyp_t curEvent = lastEvent;
     ES_Event thisEvent;
+    static ADFrame_Reader_t reader;
+    const ADFrame_t *sample;
     uint8_t returnVal = FALSE;
-    uint16_t beacon_signal = AD_ReadADPin(BEACON_DETECTOR_PIN); // read the battery voltage
+    uint16_t beacon_signal;
+
+    if (!SensorRate_Due(SENSOR_BEACON)) return (returnVal);
+    // from the shared frames like the other sensors, so HIL_MODE reaches it too
+    sample = ADFrame_Next(&reader);
+    if (sample == NULL) return (returnVal);
+    BootProfile_Mark(BOOT_BEACON_WARM);
+    beacon_signal = ADFrame_Read(sample, BEACON_DETECTOR_PIN);
 
     if (beacon_signal > BEACON_HIGH_THRESHOLD) { // is battery connected?
         curEvent = BEACON_LOST;
@@ -106,6 +140,7 @@ uint8_t DetectBeacon(void) {
         thisEvent.EventParam = beacon_signal;
         returnVal = TRUE;
         lastEvent = curEvent; // update history
+        WorldState_UpdateBeacon(curEvent == BEACON_FOUND);
 #ifndef EVENTCHECKER_TEST           // keep this as is for test harness
         PostTopHSM(thisEvent);
 #else
@@ -115,6 +150,48 @@ uint8_t DetectBeacon(void) {
     return (returnVal);
 }
 
+uint8_t CheckStatsRequest(void) {
+#if !defined(USE_KEYBOARD_INPUT) && !defined(HIL_MODE)
+    RunEvery(STATS_CHECK_PERIOD);
+    if (!IsReceiveEmpty() && GetChar() == STATE_STATS_DUMP_KEY) {
+        StateStats_Dump();
+        printf("\r\nTape readings replaced before TopHSM ran: %u",
+                EventMailbox_Replaced(PostTopHSM, TAPE_SENSOR_TRIPPED));
+        EventLanes_Dump();
+        Idle_Dump();
+        SensorTier_Dump();
+        BootProfile_Dump();
+        printf("\r\nSerial messages dropped: %u", SerialTx_Dropped());
+    }
+#endif
+    return FALSE;
+}
+
+uint8_t CheckADFrame(void) {
+    return ADFrame_Publish();
+}
+
+uint8_t CheckSensorTier(void) {
+    return SensorTier_Deliver();
+}
+
+uint8_t CheckStalls(void) {
+    RunEvery(STALL_CHECK_PERIOD);
+    return HSM_CheckStalls();
+}
+
+uint8_t CheckSerialTx(void) {
+    SerialTx_Drain();
+    return FALSE;
+}
+
+uint8_t CheckIdle(void) {
+#ifndef EVENTCHECKER_TEST
+    Idle_Wait();
+#endif
+    return FALSE;
+}
+
 //uint8_t DetectTrackWires(void) {
 //    static ES_EventTyp_t lastEvent = TRACK_WIRE_LOST;
 //    static uint16_t tw_status = 0x00;
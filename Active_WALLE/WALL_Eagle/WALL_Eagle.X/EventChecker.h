@@ -63,6 +63,53 @@
 uint8_t DetectBeacon(void);
 uint8_t DetectTrackWires(void);
 
+/**
+ * @Function CheckStatsRequest(void)
+ * @param none
+ * @return FALSE, never posts an event
+ * @brief Dumps the state machine telemetry (StateStats) when
+ *        STATE_STATS_DUMP_KEY arrives on the serial port. Does nothing while
+ *        the keyboard input service owns the serial port. */
+uint8_t CheckStatsRequest(void);
+
+/**
+ * @Function CheckADFrame(void)
+ * @param none
+ * @return TRUE if a new AD frame went out
+ * @brief Publishes each captured AD scan to the sensor services, see
+ *        ADFrame.h. */
+uint8_t CheckADFrame(void);
+
+/**
+ * @Function CheckSensorTier(void)
+ * @param none
+ * @return TRUE if an event from the sensor tier was posted
+ * @brief Posts what the interrupt level actors handed over, see
+ *        SensorTier.h. */
+uint8_t CheckSensorTier(void);
+
+/**
+ * @Function CheckStalls(void)
+ * @param none
+ * @return TRUE if a state machine was reported stalled
+ * @brief Enforces the per state dwell limits, see HSMSupervisor.h. */
+uint8_t CheckStalls(void);
+
+/**
+ * @Function CheckSerialTx(void)
+ * @param none
+ * @return FALSE, never posts an event
+ * @brief Passes queued output on to the UART, see SerialTx.h. */
+uint8_t CheckSerialTx(void);
+
+/**
+ * @Function CheckIdle(void)
+ * @param none
+ * @return FALSE, never posts an event
+ * @brief Waits for the next interrupt, see Idle.h. Must stay last in
+ *        EVENT_CHECK_LIST so it only runs when nothing else had work. */
+uint8_t CheckIdle(void);
+
 
 
 #endif	/* TEMPLATEEVENTCHECKER_H */
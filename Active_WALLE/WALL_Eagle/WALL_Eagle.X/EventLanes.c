@@ -0,0 +1,99 @@
+/*
+ * File:   EventLanes.c
+ *
+ * Priority lanes with per lane wait times, see EventLanes.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "EventLanes.h"
+#include <stdio.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define SlotOf(index) ((index) & (EVENT_LANE_DEPTH - 1))
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static const char * const LaneNames[NUM_LANES] = {
+    [LANE_URGENT] = "urgent",
+    [LANE_NORMAL] = "normal",
+};
+
+static EventLanes_t *registered = NULL;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t EventLanes_Post(EventLanes_t *lanes, Lane_t lane, uint8_t(*Enqueue)(ES_Event), ES_Event ThisEvent) {
+    EventLane_t *me = &lanes->lane[lane];
+    EventLanes_t *known;
+    ES_Event Notice;
+    uint8_t slot;
+
+    for (known = registered; known != NULL && known != lanes; known = known->next);
+    if (known == NULL) {
+        lanes->next = registered;
+        registered = lanes;
+    }
+    Notice.EventType = ThisEvent.EventType; // only for the tattle trace
+    Notice.EventParam = EVENT_LANES_NOTICE;
+    if (me->count == EVENT_LANE_DEPTH || Enqueue(Notice) != TRUE) {
+        if (me->dropped < UINT16_MAX) me->dropped++;
+        return FALSE;
+    }
+    slot = SlotOf(me->head + me->count);
+    me->events[slot] = ThisEvent;
+    me->posted_at[slot] = ES_Timer_GetTime();
+    me->count++;
+    return TRUE;
+}
+
+ES_Event EventLanes_Take(EventLanes_t *lanes, ES_Event ThisEvent) {
+    EventLane_t *me;
+    uint32_t wait;
+    uint8_t lane;
+
+    if (ThisEvent.EventParam != EVENT_LANES_NOTICE) return ThisEvent;
+    for (lane = 0; lane < NUM_LANES; lane++) {
+        me = &lanes->lane[lane];
+        if (me->count == 0) continue;
+        ThisEvent = me->events[me->head];
+        wait = ES_Timer_GetTime() - me->posted_at[me->head];
+        me->head = SlotOf(me->head + 1);
+        me->count--;
+        if (me->dispatched < UINT16_MAX) {
+            me->dispatched++;
+            me->total_wait += wait;
+        }
+        if (wait > me->max_wait) me->max_wait = wait > UINT16_MAX ? UINT16_MAX : wait;
+        return ThisEvent;
+    }
+    // cannot happen, every notice has an event behind it
+    ThisEvent.EventType = ES_NO_EVENT;
+    return ThisEvent;
+}
+
+void EventLanes_Dump(void) {
+    const EventLanes_t *lanes;
+    const EventLane_t *me;
+    uint8_t lane;
+
+    for (lanes = registered; lanes != NULL; lanes = lanes->next) {
+        for (lane = 0; lane < NUM_LANES; lane++) {
+            me = &lanes->lane[lane];
+            printf("\r\nL %s %s %u %u %lu %u", lanes->service, LaneNames[lane], me->dispatched,
+                    me->dropped, (unsigned long) (me->dispatched ? me->total_wait / me->dispatched : 0),
+                    me->max_wait);
+        }
+    }
+}
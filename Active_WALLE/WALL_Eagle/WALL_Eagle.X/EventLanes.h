@@ -0,0 +1,119 @@
+/*
+ * File:   EventLanes.h
+ *
+ * Priority lanes in front of a service's framework queue. The framework gives
+ * every service a single FIFO, so a BUMPER_TRIPPED used to wait behind
+ * whatever tape and timer events were already queued while the motors kept
+ * driving into the wall.
+ *
+ * The service's post function files each event into a lane and queues a
+ * notice in its place:
+ *
+ *   uint8_t PostTopHSM(ES_Event ThisEvent) {
+ *       return EventLanes_Post(&Lanes, LaneOf(ThisEvent), QueueTopHSM, ThisEvent);
+ *   }
+ *
+ * and its Run function swaps every notice it dequeues for the front of the
+ * most urgent lane that has something waiting:
+ *
+ *   ThisEvent = EventLanes_Take(&Lanes, ThisEvent);
+ *
+ * There is one notice per held event, so nothing is dispatched twice or
+ * left behind, but an urgent event goes out on the very next notice however
+ * many normal ones were queued before it. Events queued without a notice
+ * (ES_INIT from the Init function) pass through unchanged.
+ *
+ * Every held event has its notice in the service's queue, so the queue needs
+ * NUM_LANES * EVENT_LANE_DEPTH entries (8, TopHSM's queue_size in
+ * ES_Spec.json). With fewer, a full normal lane leaves too little room for
+ * the urgent notices and a bump is refused by the queue instead of its lane.
+ *
+ * Lanes are not interrupt safe. Like the framework queue behind them, they
+ * rely on every post, the timer responses through PostTopHSM included, being
+ * made from the ES_Run loop; interrupt level code hands its events over
+ * through SensorTier_Post().
+ *
+ * Each lane keeps how long its events waited between post and dispatch;
+ * EventLanes_Dump() prints every service's lanes with the 's' stats dump:
+ *
+ *   L <service> <lane> <dispatched> <dropped> <mean ms> <max ms>
+ */
+
+#ifndef EVENTLANES_H
+#define	EVENTLANES_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define EVENT_LANE_DEPTH 4          // a power of two
+#define EVENT_LANES_NOTICE 0x7FFE   // EventParam of a notice, never a pool handle or sensor status
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef enum {
+    LANE_URGENT,
+    LANE_NORMAL,
+    NUM_LANES,
+} Lane_t;
+
+typedef struct {
+    ES_Event events[EVENT_LANE_DEPTH];
+    uint32_t posted_at[EVENT_LANE_DEPTH];   // ES_Timer_GetTime() at post
+    uint8_t head;
+    uint8_t count;
+    uint16_t dispatched;
+    uint16_t dropped;                       // lane full or queue refused the notice
+    uint32_t total_wait;                    // ms, over all dispatched events
+    uint16_t max_wait;                      // ms
+} EventLane_t;
+
+typedef struct EventLanes_t EventLanes_t;
+
+struct EventLanes_t {
+    const char *service;
+    EventLane_t lane[NUM_LANES];
+    EventLanes_t *next;             // registered lanes, linked on first post
+};
+
+#define EVENT_LANES(name) {.service = name}
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function EventLanes_Post(EventLanes_t *lanes, Lane_t lane, uint8_t(*Enqueue)(ES_Event), ES_Event ThisEvent)
+ * @param Enqueue - posts to the service's framework queue
+ * @return TRUE if the event is held, FALSE if its lane is full or the notice
+ *         could not be queued
+ * @brief The caller keeps ownership of a pool handle on FALSE, as with any
+ *        failed post. */
+uint8_t EventLanes_Post(EventLanes_t *lanes, Lane_t lane, uint8_t(*Enqueue)(ES_Event), ES_Event ThisEvent);
+
+/**
+ * @Function EventLanes_Take(EventLanes_t *lanes, ES_Event ThisEvent)
+ * @param ThisEvent - the event the framework dequeued
+ * @return the event to dispatch
+ * @brief Replaces a notice with the oldest event of the most urgent non
+ *        empty lane and records how long it waited. */
+ES_Event EventLanes_Take(EventLanes_t *lanes, ES_Event ThisEvent);
+
+/**
+ * @Function EventLanes_Dump(void)
+ * @return None
+ * @brief Prints one L line per lane of every service that has posted. */
+void EventLanes_Dump(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* EVENTLANES_H */
@@ -0,0 +1,101 @@
+/*
+ * File:   EventMailbox.c
+ *
+ * Latest-value event slots, see EventMailbox.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "EventPool.h"
+#include "EventMailbox.h"
+#include <stddef.h>
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+typedef struct {
+    uint8_t(*post)(ES_Event);   // NULL for an unused slot
+    ES_Event event;             // freshest event, valid while pending
+    uint8_t pending;            // a notice is in the consumer's queue
+    uint16_t replaced;
+} Slot_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static Slot_t *FindSlot(uint8_t(*PostFunction)(ES_Event), ES_EventTyp_t type, uint8_t claim);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static Slot_t slots[EVENT_MAILBOX_SLOTS];
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t EventMailbox_Post(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent) {
+    Slot_t *slot = FindSlot(PostFunction, ThisEvent.EventType, TRUE);
+    ES_Event Notice;
+
+    if (slot == NULL) {
+        if (PostFunction(ThisEvent) == TRUE) return TRUE;
+        EventPool_Release(ThisEvent.EventParam);
+        return FALSE;
+    }
+    if (slot->pending) {
+        // the notice is still queued, it will deliver this one instead
+        EventPool_Release(slot->event.EventParam);
+        slot->event = ThisEvent;
+        if (slot->replaced < UINT16_MAX) slot->replaced++;
+        return TRUE;
+    }
+    Notice.EventType = ThisEvent.EventType;
+    Notice.EventParam = EVENT_MAILBOX_NOTICE;
+    if (PostFunction(Notice) != TRUE) {
+        EventPool_Release(ThisEvent.EventParam);
+        return FALSE;
+    }
+    slot->event = ThisEvent;
+    slot->pending = TRUE;
+    return TRUE;
+}
+
+ES_Event EventMailbox_Collect(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent) {
+    Slot_t *slot;
+
+    if (ThisEvent.EventParam != EVENT_MAILBOX_NOTICE) return ThisEvent;
+    slot = FindSlot(PostFunction, ThisEvent.EventType, FALSE);
+    if (slot == NULL || !slot->pending) return ThisEvent;
+    slot->pending = FALSE;
+    return slot->event;
+}
+
+uint16_t EventMailbox_Replaced(uint8_t(*PostFunction)(ES_Event), ES_EventTyp_t type) {
+    Slot_t *slot = FindSlot(PostFunction, type, FALSE);
+    return slot == NULL ? 0 : slot->replaced;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// Slots are handed out on first use and kept, there are only ever a few
+static Slot_t *FindSlot(uint8_t(*PostFunction)(ES_Event), ES_EventTyp_t type, uint8_t claim) {
+    uint8_t i;
+
+    for (i = 0; i < EVENT_MAILBOX_SLOTS && slots[i].post != NULL; i++) {
+        if (slots[i].post == PostFunction && slots[i].event.EventType == type) {
+            return &slots[i];
+        }
+    }
+    if (!claim || i == EVENT_MAILBOX_SLOTS) return NULL;
+    slots[i].post = PostFunction;
+    slots[i].event.EventType = type;
+    return &slots[i];
+}
@@ -0,0 +1,72 @@
+/*
+ * File:   EventMailbox.h
+ *
+ * Latest-value slots for high rate sensor events. TAPE_SENSOR_TRIPPED can
+ * change several times during a pivot before TopHSM gets to run, and every
+ * stale pattern used to take a place in TopHSM's 3 deep queue, ahead of (or
+ * instead of) a BUMPER_TRIPPED.
+ *
+ * The producer posts through EventMailbox_Post() instead of straight to the
+ * queue. The event is kept in a slot for its (post function, event type) and
+ * only a notice goes into the queue. While that notice is still waiting, a
+ * newer event of the same type just replaces the one in the slot (and counts
+ * the replacement), so the queue never holds more than one event per slot.
+ * The consumer turns the notice back into the freshest event with
+ *
+ *   ThisEvent = EventMailbox_Collect(PostTopHSM, ThisEvent);
+ *
+ * at the top of its Run function. Anything that is not a notice (events
+ * posted directly, deferred events being recalled) passes through unchanged.
+ *
+ * The slot owns a pool handle (EventPool.h) while it is held, a replaced
+ * handle is released, a collected one is the consumer's to consume as usual.
+ */
+
+#ifndef EVENTMAILBOX_H
+#define	EVENTMAILBOX_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define EVENT_MAILBOX_SLOTS 4
+#define EVENT_MAILBOX_NOTICE 0x7FFF // EventParam of a notice, never a pool handle or sensor status
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function EventMailbox_Post(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent)
+ * @param PostFunction - the consumer's post function
+ * @param ThisEvent - the event, its EventParam may be a pool handle
+ * @return TRUE if the event is held or replaced a held one, FALSE if the
+ *         notice could not be posted (a pool handle is released then)
+ * @brief Falls back to posting the event itself when every slot is taken. */
+uint8_t EventMailbox_Post(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent);
+
+/**
+ * @Function EventMailbox_Collect(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent)
+ * @param PostFunction - the consumer's own post function
+ * @param ThisEvent - the event being dispatched
+ * @return the freshest held event if ThisEvent is a notice, otherwise ThisEvent
+ * @brief Empties the slot, the next post of the type queues a new notice. */
+ES_Event EventMailbox_Collect(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent);
+
+/**
+ * @Function EventMailbox_Replaced(uint8_t(*PostFunction)(ES_Event), ES_EventTyp_t type)
+ * @return events of the type overwritten before they were delivered (saturates)
+ * @brief 0 for a type that never went through a slot. */
+uint16_t EventMailbox_Replaced(uint8_t(*PostFunction)(ES_Event), ES_EventTyp_t type);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* EVENTMAILBOX_H */
@@ -0,0 +1,108 @@
+/*
+ * File:   EventPool.c
+ *
+ * Fixed-block, reference counted payload pool for sensor events. See
+ * EventPool.h for the ownership rules.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "EventPool.h"
+#include <string.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define SLOT_MASK 0x00FF
+
+#define IsHandle(param) (((param) & EVENT_POOL_HANDLE) && \
+                         (((param) & SLOT_MASK) < EVENT_POOL_SIZE))
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static SensorPayload_t payloads[EVENT_POOL_SIZE];
+static uint8_t refs[EVENT_POOL_SIZE];
+
+static uint8_t in_use = 0;
+static uint8_t high_water = 0;
+static uint16_t failures = 0;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint16_t EventPool_Alloc(void) {
+    uint8_t i;
+    for (i = 0; i < EVENT_POOL_SIZE; i++) {
+        if (refs[i] == 0) {
+            refs[i] = 1;
+            memset(&payloads[i], 0, sizeof (SensorPayload_t));
+            in_use++;
+            if (in_use > high_water) high_water = in_use;
+            return EVENT_POOL_HANDLE | i;
+        }
+    }
+    failures++;
+    return EVENT_POOL_NO_HANDLE;
+}
+
+SensorPayload_t *EventPool_Get(uint16_t handle) {
+    if (!IsHandle(handle)) return NULL;
+    if (refs[handle & SLOT_MASK] == 0) return NULL;
+    return &payloads[handle & SLOT_MASK];
+}
+
+void EventPool_Retain(uint16_t handle) {
+    if (!IsHandle(handle)) return;
+    if (refs[handle & SLOT_MASK] == 0) return;
+    refs[handle & SLOT_MASK]++;
+}
+
+void EventPool_Release(uint16_t handle) {
+    uint8_t slot;
+    if (!IsHandle(handle)) return;
+    slot = handle & SLOT_MASK;
+    if (refs[slot] == 0) return;
+    if (--refs[slot] == 0) {
+        in_use--;
+    }
+}
+
+uint8_t EventPool_Post(uint8_t(*PostFunction)(ES_Event), ES_EventTyp_t type, uint16_t handle) {
+    ES_Event ThisEvent;
+    ThisEvent.EventType = type;
+    ThisEvent.EventParam = handle;
+    if (PostFunction(ThisEvent) == TRUE) {
+        return TRUE;
+    }
+    EventPool_Release(handle);
+    return FALSE;
+}
+
+void EventPool_Consume(ES_Event ThisEvent) {
+    EventPool_Release(ThisEvent.EventParam);
+}
+
+uint16_t EventPool_Param(ES_Event ThisEvent) {
+    SensorPayload_t *payload = EventPool_Get(ThisEvent.EventParam);
+    if (payload == NULL) return ThisEvent.EventParam;
+    return payload->status;
+}
+
+uint8_t EventPool_InUse(void) {
+    return in_use;
+}
+
+uint8_t EventPool_HighWater(void) {
+    return high_water;
+}
+
+uint16_t EventPool_Failures(void) {
+    return failures;
+}
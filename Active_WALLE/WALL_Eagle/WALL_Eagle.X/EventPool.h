@@ -0,0 +1,125 @@
+/*
+ * File:   EventPool.h
+ *
+ * Fixed-block pool of sensor payloads that can ride along with an ES_Event.
+ *
+ * ES_Event only has a 16 bit EventParam, so the sensor services used to pack
+ * their readings into nibbles and throw the analog values away. A service can
+ * now grab a pool slot, fill in the full reading and post the slot handle as
+ * the EventParam. The queue only ever carries the 16 bit handle, the payload
+ * itself is never copied.
+ *
+ * Handles are tagged with EVENT_POOL_HANDLE so a consumer can always tell a
+ * handle apart from a plain parameter (sub machines still synthesize events
+ * such as BUMPER_TRIPPED 0x01). Use EventPool_Param() wherever the old packed
+ * parameter is wanted and EventPool_Get() for the wide payload.
+ *
+ * Slots are reference counted. The producer owns one reference after
+ * EventPool_Alloc(); the reference travels with the event and is dropped by
+ * EventPool_Consume() once the receiving service has finished with it. Call
+ * EventPool_Retain() before posting the same handle to a second queue.
+ *
+ * The pool is only touched from the ES_Run loop (services and state machines),
+ * never from interrupts, so no locking is done.
+ */
+
+#ifndef EVENTPOOL_H
+#define	EVENTPOOL_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+#include "PinsMaster.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define EVENT_POOL_SIZE 8
+
+#define EVENT_POOL_HANDLE 0x8000     // set in EventParam when it is a pool handle
+#define EVENT_POOL_NO_HANDLE 0x0000  // returned by EventPool_Alloc when the pool is dry
+
+#define NUM_TRACK_WIRES 2
+#define NUM_BUMPERS 2
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef struct {
+    uint32_t timestamp;                     // ES_Timer_GetTime() at acquisition
+    uint16_t status;                        // packed status, same bits as the old EventParam
+    uint16_t tape_diff[NUM_TAPE_SENSORS];   // FL, ML, MR, FR flash on - flash off
+    uint16_t trackwire[NUM_TRACK_WIRES];    // raw detector 0 and 1 readings
+    uint16_t bumper[NUM_BUMPERS];           // raw left and right bumper readings
+} SensorPayload_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function EventPool_Alloc(void)
+ * @return handle to a zeroed payload holding one reference, or
+ *         EVENT_POOL_NO_HANDLE if every slot is in use
+ * @brief Callers that get EVENT_POOL_NO_HANDLE should fall back to posting the
+ *        packed status as a plain EventParam. */
+uint16_t EventPool_Alloc(void);
+
+/**
+ * @Function EventPool_Get(uint16_t handle)
+ * @return the payload behind handle, or NULL if handle is not a live handle */
+SensorPayload_t *EventPool_Get(uint16_t handle);
+
+/**
+ * @Function EventPool_Retain(uint16_t handle)
+ * @brief Adds a reference, needed before posting one handle to several queues. */
+void EventPool_Retain(uint16_t handle);
+
+/**
+ * @Function EventPool_Release(uint16_t handle)
+ * @brief Drops a reference, the slot returns to the pool when the count hits
+ *        zero. Plain (non-handle) parameters are ignored. */
+void EventPool_Release(uint16_t handle);
+
+/**
+ * @Function EventPool_Post(uint8_t (*PostFunction)(ES_Event), ES_EventTyp_t type, uint16_t handle)
+ * @return result of the post
+ * @brief Posts a handle and hands its reference to the queue. If the post
+ *        fails the reference is dropped here so the slot is not leaked. */
+uint8_t EventPool_Post(uint8_t(*PostFunction)(ES_Event), ES_EventTyp_t type, uint16_t handle);
+
+/**
+ * @Function EventPool_Consume(ES_Event ThisEvent)
+ * @brief Called once by the receiving service after it has run an event.
+ *        Releases the queue's reference if the event carried a handle. */
+void EventPool_Consume(ES_Event ThisEvent);
+
+/**
+ * @Function EventPool_Param(ES_Event ThisEvent)
+ * @return the packed 16 bit parameter, looked up in the payload for handle
+ *         events and passed straight through for everything else */
+uint16_t EventPool_Param(ES_Event ThisEvent);
+
+/**
+ * @Function EventPool_InUse(void)
+ * @return number of slots currently holding a payload */
+uint8_t EventPool_InUse(void);
+
+/**
+ * @Function EventPool_HighWater(void)
+ * @return highest EventPool_InUse() seen since reset */
+uint8_t EventPool_HighWater(void);
+
+/**
+ * @Function EventPool_Failures(void)
+ * @return number of EventPool_Alloc calls that found the pool empty */
+uint16_t EventPool_Failures(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* EVENTPOOL_H */
@@ -36,6 +36,9 @@
 #include "TapeFollowSM.h"
 #include "BumpResService.h"
 #include "DepositBallsSM.h"
+#include "WorldState.h"
+#include "StateStats.h"
+#include "HSMHistory.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -66,7 +69,7 @@ typedef enum {
 
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"SetState",
 	"BackingState",
@@ -97,10 +100,12 @@ static const char *StateNames[] = {
  * The type of state variable should match that of enum in header file. */
 
 static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
+STATE_STATS(Stats, "ExclusionRadar", StateNames);
 static uint8_t MyPriority;
+// own instances, the other parents keep theirs
+static TapeFollowSM_t TapeFollow = TAPE_FOLLOW_SM(TAPE_FOLLOW_TIMER, TAPE_FOLLOW_STARTUP_TIMER);
+static BumpResService_t BumpRes = BUMP_RES_SERVICE(BUMP_RES_TIMER);
 
-uint8_t previous_bump = 0;
-uint8_t numbertapes = 0;
 
 
 /*******************************************************************************
@@ -121,6 +126,7 @@ uint8_t InitExclusionRadar(void) {
     ES_Event returnEvent;
 
     CurrentState = InitPSubState;
+    StateStats_Enter(&Stats, CurrentState);
     returnEvent = RunExclusionRadar(INIT_EVENT);
     if (returnEvent.EventType == ES_NO_EVENT) {
         return TRUE;
@@ -146,17 +152,12 @@ uint8_t InitExclusionRadar(void) {
 ES_Event RunExclusionRadar(ES_Event ThisEvent) {
     uint8_t makeTransition = FALSE; // use to flag transition
     TemplateSubHSMState_t nextState; // <- change type to correct enum
+    HistoryMode_t history = HISTORY_NONE; // how nextState is entered
 
     ES_Tattle(); // trace call stack
 
-    // EVENT UPDATERS
-    switch (ThisEvent.EventType) {
-        case BUMPER_TRIPPED:
-            previous_bump = ThisEvent.EventParam;
-            break;
-        case TAPE_SENSOR_TRIPPED:
-            numbertapes = NumTapesTripped(ThisEvent.EventParam);
-            break;
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
     }
 
     switch (CurrentState) {
@@ -168,8 +169,8 @@ ES_Event RunExclusionRadar(ES_Event ThisEvent) {
                 // initial state
 
                 // now put the machine into the actual initial state
-                InitTapeFollowSM();
-                InitBumpResService(previous_bump);
+                InitTapeFollowSM(&TapeFollow);
+                InitBumpResService(&BumpRes, WorldState_LastBump());
                 nextState = BackingState;
                 makeTransition = TRUE;
                 ThisEvent.EventType = ES_NO_EVENT;
@@ -202,7 +203,7 @@ ES_Event RunExclusionRadar(ES_Event ThisEvent) {
                     break;
                 case ES_TIMEOUT:
                     if (ThisEvent.EventParam == EX_RADAR_TIMER) {
-                        InitTapeFollowSM();
+                        InitTapeFollowSM(&TapeFollow);
                         nextState = TapeFollowing;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -221,11 +222,11 @@ ES_Event RunExclusionRadar(ES_Event ThisEvent) {
             break;
 
         case TapeFollowing: // in the first state, replace this with correct names
-            ThisEvent = RunTapeFollowSM(ThisEvent);
+            ThisEvent = RunTapeFollowSM(&TapeFollow, ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     ES_Timer_InitTimer(EX_RADAR_TIMER, SCAN_TIME);
-                    //InitTapeFollowSM();
+                    //InitTapeFollowSM(&TapeFollow);
                     BotMoveForward(300);
                     break;
                 case BUMPER_TRIPPED:
@@ -247,10 +248,12 @@ ES_Event RunExclusionRadar(ES_Event ThisEvent) {
             break;
 
         case BumpResolving: // in the first state, replace this with correct names
-            ThisEvent = RunBumpResService(ThisEvent);
+            ThisEvent = RunBumpResService(&BumpRes, ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitBumpResService(previous_bump);
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitBumpResService(&BumpRes, WorldState_LastBump());
+                    }
                     break;
                 case BUMP_RESOLVED:
                     nextState = TapeFollowing;
@@ -398,8 +401,11 @@ ES_Event RunExclusionRadar(ES_Event ThisEvent) {
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
         RunExclusionRadar(EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
         CurrentState = nextState;
+        history = HSM_BeginResume(history);
         RunExclusionRadar(ENTRY_EVENT); // <- rename to your own Run function
+        HSM_EndResume(history);
     }
 
     ES_Tail(); // trace call stack end
@@ -0,0 +1,111 @@
+/*
+ * File:   FlashStore.c
+ *
+ * Page erase and word programming through the PIC32 NVM controller, plus the
+ * magic/checksum record format described in FlashStore.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <xc.h>
+#include <sys/kmem.h>
+#include "BOARD.h"
+#include "FlashStore.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define NVMOP_WORD_PGM 0x4001   // WREN | word program
+#define NVMOP_PAGE_ERASE 0x4004 // WREN | page erase
+#define NVMCON_WR 0x8000
+#define NVMCON_WREN 0x4000
+#define NVMCON_ERR 0x3000       // WRERR | LVDERR
+
+#define NVM_KEY1 0xAA996655
+#define NVM_KEY2 0x556699AA
+
+#define CHECKSUM_SEED 0x5A5A5A5A
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static uint8_t NVMOperation(uint32_t nvmop);
+static uint8_t ErasePage(const uint32_t *page);
+static uint8_t WriteWord(const uint32_t *address, uint32_t data);
+static uint32_t Checksum(uint32_t magic, const uint32_t *data, uint16_t words);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t FlashStore_Load(const uint32_t *page, uint32_t magic, void *data, uint16_t words) {
+    volatile const uint32_t *flash = page;
+    uint32_t *dest = data;
+    uint16_t i;
+
+    if (words > FLASH_STORE_MAX_WORDS) return FALSE;
+    if (flash[0] != magic) return FALSE;
+    if (flash[words + 1] != Checksum(magic, (const uint32_t *) &flash[1], words)) return FALSE;
+    for (i = 0; i < words; i++) {
+        dest[i] = flash[i + 1];
+    }
+    return TRUE;
+}
+
+uint8_t FlashStore_Save(const uint32_t *page, uint32_t magic, const void *data, uint16_t words) {
+    const uint32_t *src = data;
+    uint16_t i;
+
+    if (words > FLASH_STORE_MAX_WORDS) return FALSE;
+    if (!ErasePage(page)) return FALSE;
+    // magic goes last so a reset half way through leaves an invalid record
+    for (i = 0; i < words; i++) {
+        if (!WriteWord(&page[i + 1], src[i])) return FALSE;
+    }
+    if (!WriteWord(&page[words + 1], Checksum(magic, src, words))) return FALSE;
+    if (!WriteWord(&page[0], magic)) return FALSE;
+    return ((volatile const uint32_t *) page)[0] == magic;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// unlock sequence from the PIC32 family reference manual, section 5
+static uint8_t NVMOperation(uint32_t nvmop) {
+    unsigned int int_status;
+    uint8_t result;
+
+    int_status = __builtin_disable_interrupts();
+    NVMCON = nvmop;
+    NVMKEY = NVM_KEY1;
+    NVMKEY = NVM_KEY2;
+    NVMCONSET = NVMCON_WR;
+    while (NVMCON & NVMCON_WR);
+    NVMCONCLR = NVMCON_WREN;
+    result = (NVMCON & NVMCON_ERR) ? FALSE : TRUE;
+    if (int_status & 0x01) __builtin_enable_interrupts();
+    return result;
+}
+
+static uint8_t ErasePage(const uint32_t *page) {
+    NVMADDR = KVA_TO_PA(page);
+    return NVMOperation(NVMOP_PAGE_ERASE);
+}
+
+static uint8_t WriteWord(const uint32_t *address, uint32_t data) {
+    NVMADDR = KVA_TO_PA(address);
+    NVMDATA = data;
+    return NVMOperation(NVMOP_WORD_PGM);
+}
+
+static uint32_t Checksum(uint32_t magic, const uint32_t *data, uint16_t words) {
+    uint32_t sum = CHECKSUM_SEED ^ magic;
+    uint16_t i;
+    for (i = 0; i < words; i++) {
+        sum = ((sum << 5) | (sum >> 27)) ^ data[i];
+    }
+    return sum;
+}
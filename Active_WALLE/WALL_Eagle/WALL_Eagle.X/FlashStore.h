@@ -0,0 +1,66 @@
+/*
+ * File:   FlashStore.h
+ *
+ * Keeps small calibration records in program flash so they survive a reset
+ * and a reflash of the same image is not needed to retune the robot.
+ *
+ * Each client reserves a whole flash page with FLASH_STORE_PAGE() and saves a
+ * fixed size block of 32 bit words into it. A record is a magic word, the
+ * data words and a checksum; FlashStore_Load() refuses anything that does not
+ * match, so a blank or half written page just leaves the caller's defaults in
+ * place.
+ *
+ * Erasing and writing stall the CPU and mask interrupts for tens of
+ * milliseconds, only save from calibration code, never while driving.
+ */
+
+#ifndef FLASHSTORE_H
+#define	FLASHSTORE_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define FLASH_PAGE_SIZE 4096                       // PIC32MX320/340 erase page in bytes
+#define FLASH_PAGE_WORDS (FLASH_PAGE_SIZE / 4)
+#define FLASH_STORE_MAX_WORDS (FLASH_PAGE_WORDS - 2) // magic and checksum take two
+
+/* Reserves one erase page of program flash. The initializer keeps the array in
+ * flash instead of bss. */
+#define FLASH_STORE_PAGE(name) \
+    static const uint32_t name[FLASH_PAGE_WORDS] \
+    __attribute__((aligned(FLASH_PAGE_SIZE))) = {0xFFFFFFFF}
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function FlashStore_Load(const uint32_t *page, uint32_t magic, void *data, uint16_t words)
+ * @param page - page reserved with FLASH_STORE_PAGE
+ * @param magic - record tag, change it whenever the layout of data changes
+ * @param data - destination, only written if a valid record is found
+ * @param words - size of data in 32 bit words
+ * @return TRUE if a valid record was copied into data, FALSE otherwise */
+uint8_t FlashStore_Load(const uint32_t *page, uint32_t magic, void *data, uint16_t words);
+
+/**
+ * @Function FlashStore_Save(const uint32_t *page, uint32_t magic, const void *data, uint16_t words)
+ * @param page - page reserved with FLASH_STORE_PAGE
+ * @param magic - record tag
+ * @param data - words to store
+ * @param words - size of data in 32 bit words, at most FLASH_STORE_MAX_WORDS
+ * @return TRUE if the page was erased, written and read back correctly
+ * @brief Blocks with interrupts off during each erase and word write. */
+uint8_t FlashStore_Save(const uint32_t *page, uint32_t magic, const void *data, uint16_t words);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* FLASHSTORE_H */
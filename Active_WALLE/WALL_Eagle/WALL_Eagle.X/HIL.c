@@ -0,0 +1,169 @@
+/*
+ * File:   HIL.c
+ *
+ * Serial packet link to a simulated arena, see HIL.h. Only built with
+ * HIL_MODE defined.
+ */
+
+#ifdef HIL_MODE
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "serial.h"
+#include "PinsMaster.h"
+#include "HIL.h"
+#include "SerialTx.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define HIL_MAX_PAYLOAD HIL_SENSOR_LENGTH
+
+// the *_DIR_PIN and FLASH_PIN defines are "port, bit" pairs
+#define OutputSet(pin) OutputSet_(pin)
+#define OutputSet_(port, bit) ((IO_PortsReadPort(port) & (bit)) != 0)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+typedef enum {
+    WaitSync,
+    WaitType,
+    WaitLength,
+    WaitPayload,
+    WaitChecksum,
+} ParseState_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static uint8_t Parse(uint8_t byte);
+static void PutPacket(uint8_t type, const uint8_t *payload, uint8_t length);
+static void BadPacket(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static ParseState_t parse_state = WaitSync;
+static uint8_t type, length, received, sum;
+static uint8_t payload[HIL_MAX_PAYLOAD];
+
+static uint8_t last_seq;
+static uint8_t bad_packets;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t HIL_Receive(uint16_t *value) {
+    uint8_t i;
+
+    while (!IsReceiveEmpty()) {
+        if (!Parse((uint8_t) GetChar())) continue;
+        last_seq = payload[0];
+        for (i = 0; i < AD_FRAME_CHANNELS; i++) {
+            value[i] = payload[1 + 2 * i] | (payload[2 + 2 * i] << 8);
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+void HIL_Reply(void) {
+    uint8_t reply[HIL_ACTUATOR_LENGTH];
+    uint16_t left = PWM_GetDutyCycle(LEFT_PWM_PIN);
+    uint16_t right = PWM_GetDutyCycle(RIGHT_PWM_PIN);
+    uint16_t servo0 = RC_GetPulseTime(SERVO_0_OUT_PIN);
+    uint16_t servo1 = RC_GetPulseTime(SERVO_1_OUT_PIN);
+
+    reply[0] = last_seq;
+    reply[1] = left & 0xFF;
+    reply[2] = left >> 8;
+    reply[3] = right & 0xFF;
+    reply[4] = right >> 8;
+    reply[5] = (OutputSet(LEFT_DIR_PIN) ? HIL_OUT_LEFT_DIR : 0) |
+            (OutputSet(RIGHT_DIR_PIN) ? HIL_OUT_RIGHT_DIR : 0) |
+            (OutputSet(FLASH_PIN) ? HIL_OUT_FLASH : 0);
+    reply[6] = servo0 & 0xFF;
+    reply[7] = servo0 >> 8;
+    reply[8] = servo1 & 0xFF;
+    reply[9] = servo1 >> 8;
+    reply[10] = bad_packets;
+    reply[11] = 0; // reserved
+    PutPacket(HIL_ACTUATOR_FRAME, reply, HIL_ACTUATOR_LENGTH);
+}
+
+uint8_t HIL_BadPackets(void) {
+    return bad_packets;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// Takes one byte, returns TRUE once a whole valid sensor frame is in payload[]
+static uint8_t Parse(uint8_t byte) {
+    switch (parse_state) {
+        case WaitSync:
+            if (byte == HIL_SYNC) parse_state = WaitType;
+            break;
+        case WaitType:
+            type = byte;
+            sum = byte;
+            parse_state = WaitLength;
+            break;
+        case WaitLength:
+            length = byte;
+            sum += byte;
+            received = 0;
+            if (type != HIL_SENSOR_FRAME || length != HIL_SENSOR_LENGTH) {
+                BadPacket();
+            } else {
+                parse_state = WaitPayload;
+            }
+            break;
+        case WaitPayload:
+            payload[received++] = byte;
+            sum += byte;
+            if (received == length) parse_state = WaitChecksum;
+            break;
+        case WaitChecksum:
+            parse_state = WaitSync;
+            if (byte != (uint8_t) ~sum) {
+                BadPacket();
+                break;
+            }
+            return TRUE;
+    }
+    return FALSE;
+}
+
+// through the SerialTx ring like the trace lines, so a packet never has
+// text in the middle of it
+static void PutPacket(uint8_t type, const uint8_t *payload, uint8_t length) {
+    uint8_t packet[HIL_ACTUATOR_LENGTH + 4];
+    uint8_t sum = type + length;
+    uint8_t i;
+
+    packet[0] = HIL_SYNC;
+    packet[1] = type;
+    packet[2] = length;
+    for (i = 0; i < length; i++) {
+        packet[3 + i] = payload[i];
+        sum += payload[i];
+    }
+    packet[3 + length] = ~sum;
+    SerialTx_Write(packet, length + 4);
+}
+
+static void BadPacket(void) {
+    if (bad_packets < UINT8_MAX) bad_packets++;
+    parse_state = WaitSync;
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * File:   HIL.h
+ *
+ * Hardware-in-the-loop link. With HIL_MODE defined at the project level the
+ * real build runs on the Uno32 against a simulated arena: every AD frame comes
+ * from the host over serial instead of from the AD converter, and the board
+ * answers each one with what it is driving (motor PWM and direction, the tape
+ * flash, the servos). Everything downstream of ADFrame_Publish() runs
+ * unchanged. HIL.py is the host end, and on Linux it also stands in for the
+ * board through a pty so the protocol can be exercised without one.
+ *
+ * Packets, both directions:
+ *
+ *   0xA5 | type | length | payload[length] | checksum
+ *
+ * checksum is the one's complement of the 8 bit sum of type, length and the
+ * payload. Multi byte fields are little endian. Anything between packets
+ * (printf output from the board) is skipped by the receiver.
+ *
+ *   HIL_SENSOR_FRAME   host -> board, 19 bytes
+ *     seq:u8, value:u16[AD_FRAME_CHANNELS] in AD_PIN_LIST bit order
+ *   HIL_ACTUATOR_FRAME board -> host, 12 bytes, one per sensor frame
+ *     seq:u8 (echoed), left duty:u16, right duty:u16, outputs:u8
+ *     (HIL_OUT_* bits), servo 0 us:u16, servo 1 us:u16, bad packets:u8
+ *
+ * A sensor frame is 23 bytes on the wire, so 115200 baud carries ~500 frames
+ * a second, above the 2 ms the tape sensors are sampled at.
+ *
+ * The parser owns the serial receive side, so the StateStats dump key is not
+ * available in HIL_MODE.
+ */
+
+#ifndef HIL_H
+#define	HIL_H
+
+#include <stdint.h>
+#include "ADFrame.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define HIL_SYNC 0xA5
+#define HIL_SENSOR_FRAME 0x01
+#define HIL_ACTUATOR_FRAME 0x81
+
+#define HIL_SENSOR_LENGTH (1 + 2 * AD_FRAME_CHANNELS)
+#define HIL_ACTUATOR_LENGTH 12
+
+// outputs bits of HIL_ACTUATOR_FRAME
+#define HIL_OUT_LEFT_DIR 0x01
+#define HIL_OUT_RIGHT_DIR 0x02
+#define HIL_OUT_FLASH 0x04
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function HIL_Receive(uint16_t *value)
+ * @param value - AD_FRAME_CHANNELS readings, written when a frame is complete
+ * @return TRUE if a sensor frame arrived
+ * @brief Feeds whatever the serial port has received to the packet parser,
+ *        stops at the first complete sensor frame. Takes the place of
+ *        AD_IsNewDataReady() in ADFrame_Publish(). */
+uint8_t HIL_Receive(uint16_t *value);
+
+/**
+ * @Function HIL_Reply(void)
+ * @return None
+ * @brief Sends the actuator frame answering the last sensor frame, read back
+ *        from the PWM, IO port and RC drivers. */
+void HIL_Reply(void);
+
+/**
+ * @Function HIL_BadPackets(void)
+ * @return packets dropped for a bad checksum, length or type (saturates)
+ * @brief Also sent in every actuator frame. */
+uint8_t HIL_BadPackets(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HIL_H */
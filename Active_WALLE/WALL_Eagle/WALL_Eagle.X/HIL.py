@@ -0,0 +1,230 @@
+import sys
+import os
+import time
+import struct
+import threading
+import select
+import logging
+
+# HIL.py
+#
+# Host end of the hardware-in-the-loop link (packet format in HIL.h). Streams
+# sensor frames to a HIL_MODE build and prints what the board drives back.
+# The Arena class below is the stand-in world: every channel at its idle
+# reading, with the tape readings following the flash output the board sends
+# back. An arena simulator plugs in by replacing Arena.sense()/Arena.drive().
+#
+# --loopback runs the whole link on Linux without a board: a board stand-in
+# answers on the master side of a pty and the host end streams to the slave
+# side exactly as it does to the real port.
+#
+# usage: python HIL.py -p /dev/ttyUSB0 [-r frames/s] [-s seconds]   (needs pyserial)
+#        python HIL.py --loopback [-r frames/s] [-s seconds]
+
+Sync = 0xA5
+SensorFrame = 0x01
+ActuatorFrame = 0x81
+Baud = 115200
+DefaultRate = 500
+
+# AD_PIN_LIST in bit order, as in PinsMaster.h and ADFrame_t.value[]
+Channels = ['LEFT_BUMPER', 'RIGHT_BUMPER', 'TW_DETECTOR_0', 'TW_DETECTOR_1', 'BEACON_DETECTOR',
+		'FAR_LEFT_TAPE', 'MID_LEFT_TAPE', 'MID_RIGHT_TAPE', 'FAR_RIGHT_TAPE']
+SensorFormat = '<B%dH' % len(Channels)
+ActuatorFormat = '<BHHBHHBx'
+OutLeftDir = 0x01
+OutRightDir = 0x02
+OutFlash = 0x04
+
+
+def packet(type, payload):
+	body = bytearray([type, len(payload)]) + bytearray(payload)
+	return bytearray([Sync]) + body + bytearray([~sum(body) & 0xFF])
+
+
+class Parser(object):
+
+	def __init__(self):
+		self.buffer = bytearray()
+		self.badPackets = 0
+		self.text = bytearray()  # bytes between packets, printf output from the board
+
+	# returns the (type, payload) of every complete packet in data
+	def feed(self, data):
+		packets = []
+		self.buffer += data
+		while self.buffer:
+			if self.buffer[0] != Sync:
+				self.text.append(self.buffer.pop(0))
+				continue
+			if len(self.buffer) < 3:
+				break
+			length = self.buffer[2]
+			if len(self.buffer) < length + 4:
+				break
+			body = self.buffer[1:length + 3]
+			if (~sum(body) & 0xFF) != self.buffer[length + 3]:
+				# not a packet after all, the sync byte was text
+				self.badPackets += 1
+				self.text.append(self.buffer.pop(0))
+				continue
+			packets.append((body[0], bytes(body[2:])))
+			del self.buffer[:length + 4]
+		return packets
+
+	def takeText(self):
+		text = self.text.decode('ascii', 'replace')
+		self.text = bytearray()
+		return text
+
+
+class Arena(object):
+
+	def __init__(self):
+		self.flash = False
+		self.lastDrive = None
+
+	# one reading per Channels entry
+	def sense(self):
+		values = dict(LEFT_BUMPER=0, RIGHT_BUMPER=0, TW_DETECTOR_0=1000, TW_DETECTOR_1=1000,
+				BEACON_DETECTOR=1000)
+		for name in Channels:
+			if name.endswith('_TAPE'):
+				values[name] = 200 if self.flash else 900   # white floor
+		return [values[name] for name in Channels]
+
+	def drive(self, left, right, outputs, servo0, servo1):
+		self.flash = bool(outputs & OutFlash)
+		drive = (left, right, outputs & (OutLeftDir | OutRightDir), servo0, servo1)
+		if drive != self.lastDrive:
+			logging.info('left %4d%s right %4d%s servos %d %d' % (left, 'R' if outputs & OutLeftDir else 'F',
+					right, 'R' if outputs & OutRightDir else 'F', servo0, servo1))
+			self.lastDrive = drive
+
+
+# Answers every sensor frame the way HIL_Reply() does, with fixed outputs
+# and the flash toggling on each frame
+class BoardStandIn(threading.Thread):
+
+	def __init__(self, fd):
+		threading.Thread.__init__(self)
+		self.daemon = True
+		self.fd = fd
+		self.parser = Parser()
+		self.flash = 0
+
+	def run(self):
+		while True:
+			try:
+				data = os.read(self.fd, 256)
+			except OSError:
+				return
+			for type, payload in self.parser.feed(data):
+				if type != SensorFrame or len(payload) != struct.calcsize(SensorFormat):
+					self.parser.badPackets += 1
+					continue
+				seq = struct.unpack(SensorFormat, payload)[0]
+				self.flash ^= OutFlash
+				reply = struct.pack(ActuatorFormat, seq, 300, 300, self.flash, 1000, 1000,
+						min(self.parser.badPackets, 255))
+				os.write(self.fd, packet(ActuatorFrame, reply))
+
+
+# the slave side of a pty, with the part of pyserial's interface run() uses
+class PtyLink(object):
+
+	def __init__(self, fd):
+		self.fd = fd
+
+	@property
+	def in_waiting(self):
+		import fcntl
+		import termios
+		return struct.unpack('i', fcntl.ioctl(self.fd, termios.FIONREAD, b'\0' * 4))[0]
+
+	def read(self, size):
+		if not select.select([self.fd], [], [], 0.01)[0]:
+			return b''
+		return os.read(self.fd, size)
+
+	def write(self, data):
+		os.write(self.fd, data)
+
+
+def run(link, arena, rate, seconds):
+	parser = Parser()
+	sent = replies = lost = boardBad = 0
+	seq = expected = 0
+	period = 1.0 / rate
+	start = time.time()
+	deadline = start + seconds if seconds else None
+	next = start
+	while deadline is None or time.time() < deadline:
+		link.write(packet(SensorFrame, struct.pack(SensorFormat, seq, *arena.sense())))
+		sent += 1
+		next += period
+		while True:
+			for type, payload in parser.feed(link.read(link.in_waiting or 1)):
+				if type != ActuatorFrame or len(payload) != struct.calcsize(ActuatorFormat):
+					parser.badPackets += 1
+					continue
+				fields = struct.unpack(ActuatorFormat, payload)
+				replies += 1
+				lost += (fields[0] - expected) & 0xFF   # frames the board never answered
+				expected = (fields[0] + 1) & 0xFF
+				arena.drive(*fields[1:6])
+				boardBad = fields[6]
+			text = parser.takeText()
+			if text.strip():
+				sys.stdout.write(text)
+			if time.time() >= next:
+				break
+		seq = (seq + 1) & 0xFF
+	elapsed = time.time() - start
+	logging.info('%d frames in %.1f s (%.0f/s), %d replies, %d unanswered, bad packets %d here %d on the board' % (
+			sent, elapsed, sent / elapsed, replies, lost, parser.badPackets, boardBad))
+	return replies > 0
+
+
+def main(argv):
+	port = None
+	loopback = False
+	rate = DefaultRate
+	seconds = None
+	args = list(argv)
+	while args:
+		arg = args.pop(0)
+		if arg == '-p':
+			port = args.pop(0)
+		elif arg == '--loopback':
+			loopback = True
+		elif arg == '-r':
+			rate = float(args.pop(0))
+		elif arg == '-s':
+			seconds = float(args.pop(0))
+		else:
+			logging.error('unknown argument ' + arg)
+			return 1
+
+	if loopback:
+		import pty
+		import tty
+		master, slave = pty.openpty()
+		tty.setraw(master)
+		tty.setraw(slave)
+		BoardStandIn(master).start()
+		ok = run(PtyLink(slave), Arena(), rate, seconds or 2.0)
+	elif port is not None:
+		import serial
+		with serial.Serial(port, Baud, timeout=0.01) as link:
+			ok = run(link, Arena(), rate, seconds)
+	else:
+		logging.error('no port given')
+		return 1
+	return 0 if ok else 1
+
+
+if __name__ == '__main__':
+	logging.basicConfig(level=logging.INFO, format='[%(levelname)s]%(asctime)s: %(message)s',
+			stream=sys.stdout)
+	sys.exit(main(sys.argv[1:]))
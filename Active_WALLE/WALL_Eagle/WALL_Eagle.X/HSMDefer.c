@@ -0,0 +1,69 @@
+/*
+ * File:   HSMDefer.c
+ *
+ * Bounded deferred-event queues, see HSMDefer.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "TopHSM.h"
+#include "EventPool.h"
+#include "HSMDefer.h"
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static void RemoveAt(DeferQueue_t *queue, uint8_t index);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void HSM_Defer(DeferQueue_t *queue, ES_Event ThisEvent) {
+    uint8_t i;
+
+    for (i = 0; i < queue->count; i++) {
+        if (queue->events[i].EventType == ThisEvent.EventType) {
+            RemoveAt(queue, i);
+            break;
+        }
+    }
+    if (queue->count == DEFER_QUEUE_SIZE) {
+        RemoveAt(queue, 0);
+        if (queue->dropped < UINT8_MAX) queue->dropped++;
+    }
+    EventPool_Retain(ThisEvent.EventParam);
+    queue->events[queue->count++] = ThisEvent;
+}
+
+void HSM_Recall(DeferQueue_t *queue) {
+    uint8_t i;
+
+    for (i = 0; i < queue->count; i++) {
+        // hands the held reference to TopHSM's queue, or drops it on failure
+        EventPool_Post(PostTopHSM, queue->events[i].EventType, queue->events[i].EventParam);
+    }
+    queue->count = 0;
+}
+
+void HSM_FlushDeferred(DeferQueue_t *queue) {
+    while (queue->count) {
+        RemoveAt(queue, 0);
+    }
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+static void RemoveAt(DeferQueue_t *queue, uint8_t index) {
+    EventPool_Release(queue->events[index].EventParam);
+    for (queue->count--; index < queue->count; index++) {
+        queue->events[index] = queue->events[index + 1];
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * File:   HSMDefer.h
+ *
+ * Event deferral for the sub state machines. A state that gets an event it
+ * cannot act on yet (a TRACK_WIRE_FOUND while still backing up, a
+ * BEACON_FOUND while driving to the center) defers it instead of letting it
+ * pass up and get lost:
+ *
+ *   case TRACK_WIRE_FOUND:
+ *       HSM_Defer(&Deferred, ThisEvent);
+ *       ThisEvent.EventType = ES_NO_EVENT;
+ *       break;
+ *
+ * and the machine calls HSM_Recall() after every transition, which posts the
+ * held events back to TopHSM in arrival order so the next state sees them.
+ * A recalled event the new state defers again is simply held again.
+ *
+ * The queue is bounded. It holds at most one event of each type, a newer one
+ * replaces the older, and when full the oldest is dropped and counted. Pool
+ * handles (EventPool.h) are retained while held, so the payload survives the
+ * deferring dispatch. A machine that restarts from its pseudo-state calls
+ * HSM_FlushDeferred() so stale events do not leak into the new run.
+ */
+
+#ifndef HSMDEFER_H
+#define	HSMDEFER_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define DEFER_QUEUE_SIZE 3  // a full recall must fit in TopHSM's queue
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef struct {
+    ES_Event events[DEFER_QUEUE_SIZE];  // oldest first
+    uint8_t count;
+    uint8_t dropped;                    // events pushed out by a full queue
+} DeferQueue_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function HSM_Defer(DeferQueue_t *queue, ES_Event ThisEvent)
+ * @param queue - the machine's deferred events
+ * @param ThisEvent - the event to hold until the next transition
+ * @return None
+ * @brief The caller still consumes ThisEvent (ES_NO_EVENT). */
+void HSM_Defer(DeferQueue_t *queue, ES_Event ThisEvent);
+
+/**
+ * @Function HSM_Recall(DeferQueue_t *queue)
+ * @param queue - the machine's deferred events
+ * @return None
+ * @brief Posts every held event to TopHSM and empties the queue. Call after
+ *        the ENTRY of a transition. */
+void HSM_Recall(DeferQueue_t *queue);
+
+/**
+ * @Function HSM_FlushDeferred(DeferQueue_t *queue)
+ * @param queue - the machine's deferred events
+ * @return None
+ * @brief Drops every held event. */
+void HSM_FlushDeferred(DeferQueue_t *queue);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HSMDEFER_H */
@@ -0,0 +1,34 @@
+/*
+ * File:   HSMHistory.c
+ *
+ * Resume mode of the ENTRY cascade in progress, see HSMHistory.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "HSMHistory.h"
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static HistoryMode_t resume_mode = HISTORY_NONE;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+HistoryMode_t HSM_BeginResume(HistoryMode_t mode) {
+    HistoryMode_t previous = resume_mode;
+    resume_mode = mode;
+    return previous;
+}
+
+void HSM_EndResume(HistoryMode_t previous) {
+    resume_mode = previous;
+}
+
+HistoryMode_t HSM_ResumeMode(void) {
+    return resume_mode;
+}
@@ -0,0 +1,72 @@
+/*
+ * File:   HSMHistory.h
+ *
+ * History for the sub state machines. A parent that enters a child state can
+ * either restart the child from its initial pseudo-state or resume it in the
+ * state it was last in:
+ *
+ *   HISTORY_NONE     restart, same as calling the child's Init function
+ *   HISTORY_SHALLOW  re-enter the child's last state, the machines below it
+ *                    restart from their own entry actions
+ *   HISTORY_DEEP     re-enter the last state all the way down, nothing restarts
+ *
+ * A resume re-runs the ES_ENTRY actions of the remembered states, so timers
+ * and motor commands are set up again. While the ENTRY cascade runs,
+ * HSM_ResumeMode() tells an entry action whether it is a real transition
+ * (HISTORY_NONE) or a resume. Entry actions that init a sub machine skip the
+ * init on a deep resume, entry actions that advance progress (a sweep width,
+ * a count) skip it on any resume.
+ *
+ * The cascade is synchronous, so one module wide mode is enough. Every
+ * transition block that runs ENTRY wraps it in HSM_BeginResume() and
+ * HSM_EndResume(), a plain transition passes HISTORY_NONE.
+ */
+
+#ifndef HSMHISTORY_H
+#define	HSMHISTORY_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef enum {
+    HISTORY_NONE,
+    HISTORY_SHALLOW,
+    HISTORY_DEEP,
+} HistoryMode_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function HSM_BeginResume(HistoryMode_t mode)
+ * @param mode - how the states about to be entered were reached
+ * @return the mode in effect before, hand it to HSM_EndResume()
+ * @brief Call right before running ENTRY_EVENT. */
+HistoryMode_t HSM_BeginResume(HistoryMode_t mode);
+
+/**
+ * @Function HSM_EndResume(HistoryMode_t previous)
+ * @param previous - the value HSM_BeginResume() returned
+ * @return None
+ * @brief Call right after running ENTRY_EVENT. */
+void HSM_EndResume(HistoryMode_t previous);
+
+/**
+ * @Function HSM_ResumeMode(void)
+ * @return HISTORY_NONE on a plain transition, otherwise the resume mode the
+ *         current ENTRY cascade runs under
+ * @brief For entry actions, see the file header. */
+HistoryMode_t HSM_ResumeMode(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HSMHISTORY_H */
@@ -0,0 +1,101 @@
+/*
+ * File:   HSMSupervisor.c
+ *
+ * Per state dwell limits and recovery transitions, see HSMSupervisor.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "TopHSM.h"
+#include "SerialTx.h"
+#include "HSMSupervisor.h"
+#include <stddef.h>
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static const DwellLimit_t *LimitOf(const Supervisor_t *supervisor, uint8_t state);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static Supervisor_t *supervisors = NULL;
+static uint8_t num_supervisors = 0;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void HSM_Supervise(Supervisor_t *supervisor) {
+    Supervisor_t *entry;
+
+    for (entry = supervisors; entry != NULL && entry != supervisor; entry = entry->next);
+    if (entry == NULL) {
+        supervisor->id = num_supervisors++;
+        supervisor->next = supervisors;
+        supervisors = supervisor;
+    }
+    supervisor->stalled = STATE_STATS_NONE;
+}
+
+uint8_t HSM_CheckStalls(void) {
+    uint32_t now = ES_Timer_GetTime();
+    const StateStats_t *stats;
+    const DwellLimit_t *limit;
+    Supervisor_t *supervisor;
+    ES_Event ThisEvent;
+
+    for (supervisor = supervisors; supervisor != NULL; supervisor = supervisor->next) {
+        stats = supervisor->stats;
+        // a sub machine whose parent state is not active is not running
+        if (!stats->timing) continue;
+        limit = LimitOf(supervisor, stats->current);
+        if (limit == NULL || now - stats->entered_at < limit->max_dwell) continue;
+        if (supervisor->stalled == stats->current && supervisor->stalled_at == stats->entered_at) {
+            continue; // already reported this visit
+        }
+        ThisEvent.EventType = STATE_STALLED;
+        ThisEvent.EventParam = supervisor->id;
+        if (PostTopHSM(ThisEvent) == FALSE) return FALSE; // try again next time
+        supervisor->stalled = stats->current;
+        supervisor->stalled_at = stats->entered_at;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+uint8_t HSM_StallRecovery(Supervisor_t *supervisor, ES_Event ThisEvent) {
+    const StateStats_t *stats = supervisor->stats;
+    const DwellLimit_t *limit;
+
+    if (ThisEvent.EventParam != supervisor->id) return STATE_STATS_NONE;
+    if (!stats->timing || supervisor->stalled != stats->current ||
+            supervisor->stalled_at != stats->entered_at) {
+        return STATE_STATS_NONE; // left the state while the event was queued
+    }
+    limit = LimitOf(supervisor, stats->current);
+    supervisor->stalled = STATE_STATS_NONE;
+    SerialTx_Printf("\r\nSTALL %s %s %lu -> %s", stats->machine,
+            stats->state_names[limit->state],
+            (unsigned long) (ES_Timer_GetTime() - stats->entered_at),
+            stats->state_names[limit->recovery]);
+    return limit->recovery;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+static const DwellLimit_t *LimitOf(const Supervisor_t *supervisor, uint8_t state) {
+    uint8_t i;
+
+    for (i = 0; i < supervisor->num_limits; i++) {
+        if (supervisor->limits[i].state == state) return &supervisor->limits[i];
+    }
+    return NULL;
+}
@@ -0,0 +1,110 @@
+/*
+ * File:   HSMSupervisor.h
+ *
+ * Stall supervision for the state machines. Some states only leave on a
+ * sensor event (RadarState on BEACON_FOUND, RealignState on the track wire),
+ * so a single missed edge used to hold the robot there for the rest of the
+ * match. A machine now lists, next to its STATE_STATS() table, the states
+ * that must not wait forever, each with a maximum dwell and the state to
+ * recover into:
+ *
+ *   static const DwellLimit_t DwellLimits[] = {
+ *       {RadarState, RADAR_TIMEOUT, MoveCenterState},
+ *   };
+ *   HSM_SUPERVISOR(Supervisor, Stats, DwellLimits);
+ *
+ * registers it from its Init function with HSM_Supervise() and takes the
+ * recovery transition from its Run function, next to BUMPER_TRIPPED:
+ *
+ *   case STATE_STALLED:
+ *       recovery = HSM_StallRecovery(&Supervisor, ThisEvent);
+ *       if (recovery != STATE_STATS_NONE) { nextState = recovery; ... }
+ *
+ * No ES timer is used. The CheckStalls event checker calls
+ * HSM_CheckStalls() every STALL_CHECK_PERIOD, which compares each machine's
+ * StateStats current state and entered_at against its limits and posts
+ * STATE_STALLED to TopHSM, at most once per visit. A sub machine whose
+ * parent state is not active has left its state (StateStats_Leave()) and is
+ * not checked. The event passes down the hierarchy like any other.
+ * HSM_StallRecovery() only answers while the machine is still in the visit
+ * that stalled, and logs every recovery it hands out:
+ *
+ *   STALL <machine> <state> <dwell ms> -> <recovery state>
+ */
+
+#ifndef HSMSUPERVISOR_H
+#define	HSMSUPERVISOR_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+#include "StateStats.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define STALL_CHECK_PERIOD 20   // ms, dwell limits are seconds
+
+/* Declares the supervisor for one machine. stats is its STATE_STATS() table,
+ * limits its DwellLimit_t array (not a pointer). */
+#define HSM_SUPERVISOR(name, stats, limits) \
+    static Supervisor_t name = {&stats, limits, sizeof (limits) / sizeof (limits[0]), \
+        0, STATE_STATS_NONE, 0, 0}
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef struct {
+    uint8_t state;
+    uint16_t max_dwell;     // ms
+    uint8_t recovery;       // state to go to once max_dwell has passed
+} DwellLimit_t;
+
+typedef struct Supervisor_t Supervisor_t;
+
+struct Supervisor_t {
+    const StateStats_t *stats;
+    const DwellLimit_t *limits;
+    uint8_t num_limits;
+    uint8_t id;             // EventParam of this machine's STATE_STALLED
+    uint8_t stalled;        // state reported, STATE_STATS_NONE if none
+    uint32_t stalled_at;    // entered_at of the visit reported
+    Supervisor_t *next;     // registered supervisors
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function HSM_Supervise(Supervisor_t *supervisor)
+ * @param supervisor - the machine's limits
+ * @return None
+ * @brief Starts checking the machine, call from its Init function. Calling it
+ *        again only forgets a stall that was not acted on. */
+void HSM_Supervise(Supervisor_t *supervisor);
+
+/**
+ * @Function HSM_CheckStalls(void)
+ * @return TRUE if a STATE_STALLED was posted
+ * @brief Posts STATE_STALLED for the first machine found over its limit, the
+ *        others are found on the next calls. */
+uint8_t HSM_CheckStalls(void);
+
+/**
+ * @Function HSM_StallRecovery(Supervisor_t *supervisor, ES_Event ThisEvent)
+ * @param supervisor - the machine's limits
+ * @param ThisEvent - a STATE_STALLED event
+ * @return the state to transition to, or STATE_STATS_NONE if the event is
+ *         for another machine or the machine has moved on since
+ * @brief Logs the intervention when it returns a state. */
+uint8_t HSM_StallRecovery(Supervisor_t *supervisor, ES_Event ThisEvent);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HSMSUPERVISOR_H */
@@ -0,0 +1,381 @@
+import sys
+import os
+import re
+import json
+import logging
+
+# HSM_Verify.py
+#
+# Host-side checker for the state machines listed in ES_Spec.json. Every Run*
+# function is parsed into a transition graph straight from the source: the
+# states come from the *State_t enum, the edges from the nextState assignments
+# under each "case State:" of the switch on CurrentState (me->state), labelled with the
+# event case (or EventType test) they sit under. A transition to HistoryState
+# (see HSMHistory.h) is drawn back to every state that transitions in. A
+# transition to recovery (see HSMSupervisor.h) is drawn from each state in the
+# machine's DwellLimit_t table to its recovery state, on STATE_STALLED.
+#
+# Reported per machine:
+#   fall-through    a non-empty case that runs on into the next label, at the
+#                   state level or inside a state's event switch
+#   pre-switch      a nextState set before the switch on CurrentState, which
+#                   applies in every state
+#   unreachable     a state nothing transitions into
+#   dead end        a reachable state with no transition out
+#   pseudo-state    a transition back into the initial pseudo-state, which
+#                   only ever answers ES_INIT
+#   timeout         a state that starts a timer but never handles ES_TIMEOUT,
+#                   or handles it without checking which timer expired
+# and across all machines, user events from the spec that no state handles
+# (groups marked "internal" are left out).
+#
+# A Graphviz .dot file is written per machine (fall-through edges dashed red,
+# unreachable states grey). Render with: dot -Tpng build/graphs/TopHSM.dot
+#
+# usage: python HSM_Verify.py [-o outdir] [machine.c ...]   (run from the project directory)
+#        exits with 1 if anything was reported
+
+SpecName = 'ES_Spec.json'
+DefaultOutDir = os.path.join('build', 'graphs')
+HistoryTarget = 'HistoryState'
+HistoryLabel = ' (H)'
+RecoveryTarget = 'recovery'
+RecoveryLabel = 'STATE_STALLED'
+
+enumRegEx = re.compile(r"typedef[ ]+enum[ ]*\{(?P<enum_names>[^\}]+)\}[ ]+(?P<type>[A-Za-z0-9_]*[sS]tate_t);", re.MULTILINE)
+enumNameRegEx = re.compile(r"(?P<Name>[a-zA-Z0-9_]+)[ ]*(=[^,]*)?,")
+runRegEx = re.compile(r"ES_Event[ ]+(?P<name>Run[A-Za-z0-9_]+)[ ]*\([ ]*([A-Za-z0-9_]+[ ]*\*[ ]*me[ ]*,[ ]*)?ES_Event[ ]+ThisEvent[ ]*\)[ \n]*\{")
+switchRegEx = re.compile(r"\bswitch[ ]*\((?P<expr>[^)]*)\)[ \n]*\{")
+labelRegEx = re.compile(r"\b(case[ ]+(?P<name>[A-Za-z0-9_]+)|default)[ ]*:(?!:)")
+nextStateRegEx = re.compile(r"\bnextState[ ]*=[ ]*(?P<target>[A-Za-z0-9_]+)[ ]*;")
+eventTestRegEx = re.compile(r"ThisEvent\.EventType[ ]*==[ ]*(?P<event>[A-Za-z0-9_]+)")
+timerRegEx = re.compile(r"ES_Timer_InitTimer[ ]*\([ ]*(?P<timer>[A-Za-z0-9_]+)")
+subMachineRegEx = re.compile(r"ThisEvent[ ]*=[ ]*(?P<run>Run[A-Za-z0-9_]+)[ ]*\([ ]*(&[A-Za-z0-9_]+[ ]*,[ ]*)?ThisEvent[ ]*\)")
+dwellLimitsRegEx = re.compile(r"DwellLimit_t[ ]+[A-Za-z0-9_]+[ ]*\[[ ]*\][ ]*=[ ]*\{(?P<limits>[^;]*)\}[ ]*;")
+dwellLimitRegEx = re.compile(r"\{[ \n]*(?P<state>[A-Za-z0-9_]+)[ \n]*,[^,{}]*,[ \n]*(?P<recovery>[A-Za-z0-9_]+)[ \n]*\}")
+terminatorRegEx = re.compile(r"(\bbreak|\breturn\b[^;]*|\bcontinue|\bgoto[ ]+[A-Za-z0-9_]+)[ ]*;[ \n]*$")
+
+
+# blanks out comments and string literals, keeping offsets and line breaks
+def stripComments(text):
+	def blank(match):
+		return re.sub(r"[^\n]", ' ', match.group(0))
+	return re.sub(r'//[^\n]*|/\*.*?\*/|"(\\.|[^"\\])*"', blank, text, flags=re.DOTALL)
+
+
+# index one past the brace that closes the one at text[start]
+def matchBrace(text, start):
+	depth = 0
+	for i in range(start, len(text)):
+		if text[i] == '{':
+			depth += 1
+		elif text[i] == '}':
+			depth -= 1
+			if depth == 0:
+				return i + 1
+	raise ValueError('unbalanced braces')
+
+
+# text with every nested brace block replaced by spaces, so only depth 0 remains
+def topLevel(text):
+	out = list(text)
+	depth = 0
+	for i, c in enumerate(text):
+		if c == '{':
+			depth += 1
+		if depth > 0 and c != '\n':
+			out[i] = ' '
+		if c == '}':
+			depth -= 1
+	return ''.join(out)
+
+
+class Segment(object):
+	# the statements between one group of stacked case labels and the next
+
+	def __init__(self, labels, text, offset, line):
+		self.labels = labels
+		self.text = text
+		self.offset = offset
+		self.line = line
+		self.fallsThrough = False
+
+
+# splits the body of a switch into segments at its own case labels
+def splitSwitch(body, bodyOffset, lineOf):
+	flat = topLevel(body)
+	marks = list(labelRegEx.finditer(flat))
+	segments = []
+	pending = []
+	for i, mark in enumerate(marks):
+		pending.append(mark.group('name') or 'default')
+		end = marks[i + 1].start() if i + 1 < len(marks) else len(body)
+		text = body[mark.end():end]
+		if text.strip() == '':
+			continue # stacked label
+		segments.append(Segment(pending, text, bodyOffset + mark.end(), lineOf(bodyOffset + mark.start())))
+		pending = []
+	if pending:
+		segments.append(Segment(pending, '', bodyOffset + len(body), lineOf(bodyOffset + len(body))))
+	for i, segment in enumerate(segments[:-1]):
+		# running on into a bare "break;" does nothing, so it is not counted
+		if not terminatorRegEx.search(segment.text.rstrip()) and \
+				re.sub(r"\s", '', segments[i + 1].text) != 'break;':
+			segment.fallsThrough = True
+	return segments
+
+
+# finds the first switch on expr in text, returns (start, bodyStart, bodyEnd)
+def findSwitch(text, expr):
+	for match in switchRegEx.finditer(text):
+		if match.group('expr').replace(' ', '') == expr:
+			end = matchBrace(text, match.end() - 1)
+			return match.start(), match.end(), end - 1
+	return None
+
+
+class Machine(object):
+
+	def __init__(self, fileName):
+		self.fileName = fileName
+		self.name = os.path.splitext(os.path.basename(fileName))[0]
+		with open(fileName, 'r') as f:
+			self.source = stripComments(f.read())
+		self.states = []
+		self.pseudoState = None
+		self.edges = []          # (from, to, label, viaFallThrough)
+		self.handled = set()     # events this machine reacts to
+		self.children = {}       # state -> sub machine run functions
+		self.findings = []
+
+	def lineOf(self, offset):
+		return self.source.count('\n', 0, offset) + 1
+
+	def report(self, line, message):
+		self.findings.append('%s:%d: %s' % (self.fileName, line, message))
+
+	def parse(self):
+		enum = enumRegEx.search(self.source)
+		if enum is None:
+			raise ValueError('no state enum')
+		self.states = [m.group('Name') for m in enumNameRegEx.finditer(enum.group('enum_names') + ',')]
+		self.pseudoState = self.states[0]
+
+		run = runRegEx.search(self.source)
+		if run is None:
+			raise ValueError('no Run function')
+		bodyStart = run.end()
+		body = self.source[bodyStart:matchBrace(self.source, run.end() - 1) - 1]
+
+		# instance machines (TapeFollowSM_t and the like) keep it in me->state
+		stateSwitch = findSwitch(body, 'CurrentState') or findSwitch(body, 'me->state')
+		if stateSwitch is None:
+			raise ValueError('no switch on CurrentState')
+		switchStart, caseStart, caseEnd = stateSwitch
+
+		# anything before the state switch runs in every state
+		preamble = body[:switchStart]
+		global_edges = self.eventEdges(preamble, bodyStart)
+		# the supervisor's recovery only applies in the states it limits
+		global_edges = [edge for edge in global_edges if edge[0] != RecoveryTarget]
+		for target, label, line in global_edges:
+			self.report(line, 'nextState = %s is set before the state switch, it applies in every state' % target)
+		limits = dwellLimitsRegEx.search(self.source)
+		if limits is not None:
+			for match in dwellLimitRegEx.finditer(limits.group('limits')):
+				self.edges.append((match.group('state'), match.group('recovery'), RecoveryLabel, False))
+
+		segments = splitSwitch(body[caseStart:caseEnd], bodyStart + caseStart, self.lineOf)
+		self.cases = {}
+		for segment in segments:
+			for label in segment.labels:
+				self.cases[label] = segment
+
+		for i, segment in enumerate(segments):
+			if segment.fallsThrough:
+				self.report(segment.line, 'state %s falls through into %s' %
+						('/'.join(segment.labels), '/'.join(segments[i + 1].labels)))
+			# a state runs its own segment and every one it falls into
+			chain = [segment]
+			j = i
+			while segments[j].fallsThrough:
+				j += 1
+				chain.append(segments[j])
+			for state in segment.labels:
+				if state == 'default':
+					continue
+				self.analyzeState(state, chain)
+				for target, label, line in global_edges:
+					self.edges.append((state, target, label, False))
+
+		for state in self.states:
+			if state not in self.cases:
+				self.report(self.lineOf(enum.start()), 'state %s has no case in %s' % (state, run.group('name')))
+		self.resolveHistory()
+
+	# nextState = HistoryState returns to the state that was left for source
+	def resolveHistory(self):
+		edges = []
+		for source, target, label, fall in self.edges:
+			if target != HistoryTarget:
+				edges.append((source, target, label, fall))
+				continue
+			for previous, into, l, f in self.edges:
+				if into == source and previous not in (source, self.pseudoState):
+					edges.append((source, previous, label + HistoryLabel, fall))
+		self.edges = edges
+
+	# (target, event label, line) for every nextState in text, resolving the
+	# event either from an enclosing event switch or an EventType test
+	def eventEdges(self, text, offset):
+		edges = []
+		eventSwitch = findSwitch(text, 'ThisEvent.EventType')
+		outside = text
+		if eventSwitch is not None:
+			switchStart, bodyStart, bodyEnd = eventSwitch
+			outside = text[:switchStart] + ' ' * (bodyEnd + 1 - switchStart) + text[bodyEnd + 1:]
+			for segment in splitSwitch(text[bodyStart:bodyEnd], offset + bodyStart, self.lineOf):
+				self.handled.update(segment.labels)
+				for match in nextStateRegEx.finditer(segment.text):
+					edges.append((match.group('target'), '|'.join(segment.labels), segment.line))
+		tests = eventTestRegEx.findall(outside)
+		self.handled.update(tests)
+		for match in nextStateRegEx.finditer(outside):
+			edges.append((match.group('target'), '|'.join(tests) or '*', self.lineOf(offset + match.start())))
+		return edges
+
+	def analyzeState(self, state, chain):
+		timers = set()
+		handlesTimeout = False
+		checksParam = False
+		for n, segment in enumerate(chain):
+			eventSwitch = findSwitch(segment.text, 'ThisEvent.EventType')
+			if eventSwitch is not None:
+				switchStart, bodyStart, bodyEnd = eventSwitch
+				events = splitSwitch(segment.text[bodyStart:bodyEnd], segment.offset + bodyStart, self.lineOf)
+				for k, event in enumerate(events[:-1]):
+					if event.fallsThrough and n == 0:
+						self.report(event.line, 'in state %s, event %s falls through into %s' %
+								(state, '/'.join(event.labels), '/'.join(events[k + 1].labels)))
+				for event in events:
+					if 'ES_TIMEOUT' in event.labels:
+						handlesTimeout = True
+						checksParam = checksParam or 'EventParam' in event.text
+			if 'ES_TIMEOUT' in eventTestRegEx.findall(segment.text):
+				handlesTimeout = True
+				checksParam = checksParam or 'EventParam' in segment.text
+			timers.update(timerRegEx.findall(segment.text))
+			for match in subMachineRegEx.finditer(segment.text):
+				self.children.setdefault(state, []).append(match.group('run'))
+			for target, label, line in self.eventEdges(segment.text, segment.offset):
+				self.edges.append((state, target, label, n > 0))
+
+		if timers and not handlesTimeout and state not in self.children:
+			self.report(chain[0].line, 'state %s starts %s but never handles ES_TIMEOUT' % (state, ', '.join(sorted(timers))))
+		if handlesTimeout and not checksParam:
+			self.report(chain[0].line, 'state %s reacts to any ES_TIMEOUT without checking EventParam' % state)
+
+	def checkGraph(self):
+		reachable = set([self.pseudoState])
+		frontier = [self.pseudoState]
+		while frontier:
+			state = frontier.pop()
+			for source, target, label, fall in self.edges:
+				# a history target was already visited to be remembered
+				if label.endswith(HistoryLabel):
+					continue
+				if source == state and target not in reachable:
+					reachable.add(target)
+					frontier.append(target)
+		self.reachable = reachable
+		line = self.lineOf(enumRegEx.search(self.source).start())
+		for state in self.states:
+			if state not in self.cases:
+				continue # already reported as having no case
+			if state not in reachable:
+				self.report(line, 'state %s is unreachable' % state)
+			elif state != self.pseudoState:
+				if not [e for e in self.edges if e[0] == state and e[1] != state]:
+					self.report(self.cases[state].line, 'state %s is a dead end (no transition out)' % state)
+		for source, target, label, fall in self.edges:
+			if target == self.pseudoState and source != self.pseudoState:
+				self.report(self.cases[source].line if source in self.cases else line,
+						'%s on %s transitions back into pseudo-state %s' % (source, label, target))
+			if target not in self.states:
+				self.report(line, '%s transitions to unknown state %s' % (source, target))
+
+	def dot(self):
+		out = ['digraph %s {\n' % self.name, '\trankdir=LR;\n', '\tnode [shape=box, style=rounded];\n']
+		out.append('\t"%s" [shape=point];\n' % self.pseudoState)
+		for state in self.states[1:]:
+			attrs = []
+			label = state
+			if state in self.children:
+				label += '\\n[' + ', '.join(self.children[state]) + ']'
+			attrs.append('label="%s"' % label)
+			if state not in self.reachable:
+				attrs.append('color=grey, fontcolor=grey')
+			out.append('\t"%s" [%s];\n' % (state, ', '.join(attrs)))
+		for source, target, label, fall in sorted(set(self.edges)):
+			style = ', style=dashed, color=red' if fall else ''
+			out.append('\t"%s" -> "%s" [label="%s"%s];\n' % (source, target, label, style))
+		out.append('}\n')
+		return ''.join(out)
+
+
+def userEvents(specName):
+	with open(specName, 'r') as f:
+		spec = json.load(f)
+	events = []
+	for group in spec['events']:
+		# internal groups are service plumbing, no state machine should see them
+		if not group.get('internal', False):
+			events.extend(group['names'])
+	return spec['state_machines'], events
+
+
+def main(argv):
+	outDir = DefaultOutDir
+	files = []
+	args = list(argv)
+	while args:
+		arg = args.pop(0)
+		if arg == '-o':
+			outDir = args.pop(0)
+		else:
+			files.append(arg)
+	machineFiles, events = userEvents(SpecName)
+	if not files:
+		files = machineFiles
+
+	if not os.path.isdir(outDir):
+		os.makedirs(outDir)
+	handled = set()
+	count = 0
+	for fileName in files:
+		machine = Machine(fileName)
+		try:
+			machine.parse()
+		except ValueError as e:
+			logging.warning('skipping %s: %s' % (fileName, e))
+			continue
+		machine.checkGraph()
+		handled.update(machine.handled)
+		with open(os.path.join(outDir, machine.name + '.dot'), 'w') as f:
+			f.write(machine.dot())
+		for finding in machine.findings:
+			print(finding)
+		count += len(machine.findings)
+
+	for event in events:
+		if event not in handled:
+			print('%s: event %s is handled in no state' % (SpecName, event))
+			count += 1
+	logging.info('%d finding(s), graphs in %s' % (count, outDir))
+	return 1 if count else 0
+
+
+if __name__ == '__main__':
+	logging.basicConfig(level=logging.INFO, format='[%(levelname)s]%(asctime)s: %(message)s',
+			stream=sys.stdout)
+	sys.exit(main(sys.argv[1:]))
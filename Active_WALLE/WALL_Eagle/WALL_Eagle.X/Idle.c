@@ -0,0 +1,81 @@
+/*
+ * File:   Idle.c
+ *
+ * Waits out the idle time between events, see Idle.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <xc.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "serial.h"
+#include "ADFrame.h"
+#include "Idle.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define CORE_TICKS_PER_MS (80000000L / 2 / 1000)   // the core timer counts every other SYSCLK
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static uint64_t idle_ticks;         // core timer ticks spent in wait this window
+static uint32_t window_start;       // ES_Timer_GetTime() at the last dump
+static uint32_t waits;
+static uint32_t wakes[NUM_WAKE_REASONS];
+static uint8_t unsettled = FALSE;   // last wake was neither the tick nor the UART
+static uint32_t frame_seq;          // ADFrame_Sequence() before that wait
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void Idle_Wait(void) {
+    uint32_t tick = ES_Timer_GetTime();
+    uint32_t start;
+
+    // the interrupt flags are cleared by their handlers, so the wake sources
+    // are told apart by what they leave behind. A finished AD scan only shows
+    // once CheckADFrame has published it (AD_IsNewDataReady() clears the flag
+    // and must stay ADFrame's), which is by the next time round here.
+    if (unsettled) {
+        wakes[ADFrame_Sequence() != frame_seq ? WAKE_ADC : WAKE_OTHER]++;
+        unsettled = FALSE;
+    }
+    frame_seq = ADFrame_Sequence();
+
+    start = _CP0_GET_COUNT();
+    _wait();
+    idle_ticks += _CP0_GET_COUNT() - start;
+    waits++;
+
+    if (ES_Timer_GetTime() != tick) {
+        wakes[WAKE_TIMER]++;
+    } else if (!IsReceiveEmpty() || !IsTransmitEmpty()) {
+        wakes[WAKE_UART]++;
+    } else {
+        unsettled = TRUE;
+    }
+}
+
+void Idle_Dump(void) {
+    uint32_t now = ES_Timer_GetTime();
+    uint64_t window = (uint64_t) (now - window_start) * CORE_TICKS_PER_MS;
+    uint8_t i;
+
+    printf("\r\nI %u %lu %lu %lu %lu %lu", (unsigned) (window ? idle_ticks * 100 / window : 0),
+            (unsigned long) waits, (unsigned long) wakes[WAKE_TIMER], (unsigned long) wakes[WAKE_ADC],
+            (unsigned long) wakes[WAKE_UART], (unsigned long) wakes[WAKE_OTHER]);
+    window_start = now;
+    idle_ticks = 0;
+    waits = 0;
+    for (i = 0; i < NUM_WAKE_REASONS; i++) {
+        wakes[i] = 0;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * File:   Idle.h
+ *
+ * Idles the core when there is nothing to do. ES_Run only calls the event
+ * checkers once every service queue has drained, and ES_CheckUserEvents()
+ * stops at the first checker that posts, so the last checker in
+ * EVENT_CHECK_LIST (CheckIdle) only runs when no service is ready and no
+ * checker found anything. It calls Idle_Wait(), which puts the PIC32 into
+ * Idle with the wait instruction until the next interrupt: the 1 ms framework
+ * tick, the 500 us sensor tier tick (SensorTier.h), the end of an AD scan or a
+ * UART byte. A wake that raced the wait costs at most one tick. A tier tick
+ * that captured a frame counts as an adc wake, one that did not as other.
+ *
+ * OSCCON.SLPEN stays 0 from reset, so wait is Idle rather than Sleep and the
+ * peripherals and the core timer keep running.
+ *
+ * The time spent waiting and the reason for each wake are kept for the 's'
+ * stats dump, Idle_Dump() prints them and starts a new window:
+ *
+ *   I <idle %> <waits> <timer wakes> <adc wakes> <uart wakes> <other wakes>
+ */
+
+#ifndef IDLE_H
+#define	IDLE_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef enum {
+    WAKE_TIMER,
+    WAKE_ADC,
+    WAKE_UART,
+    WAKE_OTHER,
+    NUM_WAKE_REASONS,
+} WakeReason_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Idle_Wait(void)
+ * @return None
+ * @brief Waits for the next interrupt and accounts for the time and the wake
+ *        reason. Only call it when nothing is ready to run. */
+void Idle_Wait(void);
+
+/**
+ * @Function Idle_Dump(void)
+ * @return None
+ * @brief Prints the I line for the window since the last dump. */
+void Idle_Dump(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* IDLE_H */
@@ -32,6 +32,10 @@
 #include "BOARD.h"
 #include "TopHSM.h"
 #include "InitSubHSM.h"
+#include "StateStats.h"
+#include "HSMSupervisor.h"
+#include "BootProfile.h"
+#include "motors.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -39,6 +43,7 @@
 #define MOVE_TIME 800
 #define TURN_AROUND_TIME 1500
 #define INIT_DELAY_TIME 2500
+#define RADAR_TIMEOUT 8000 // more than a full turn at SLOW_SPEED
 
 #define FAST_SPEED 500
 #define SLOW_SPEED 400
@@ -51,7 +56,7 @@ typedef enum {
     TurnAroundState,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"InitDelayState",
 	"RadarState",
@@ -74,6 +79,12 @@ static const char *StateNames[] = {
  * The type of state variable should match that of enum in header file. */
 
 static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
+STATE_STATS(Stats, "InitSubHSM", StateNames);
+// no beacon in a full turn, go in without it
+static const DwellLimit_t DwellLimits[] = {
+    {RadarState, RADAR_TIMEOUT, MoveInState},
+};
+HSM_SUPERVISOR(Supervisor, Stats, DwellLimits);
 static uint8_t MyPriority;
 
 
@@ -95,6 +106,8 @@ uint8_t InitInitSubHSM(void) {
     ES_Event returnEvent;
 
     CurrentState = InitPSubState;
+    StateStats_Enter(&Stats, CurrentState);
+    HSM_Supervise(&Supervisor);
     returnEvent = RunInitSubHSM(INIT_EVENT);
     if (returnEvent.EventType == ES_NO_EVENT) {
         return TRUE;
@@ -120,9 +133,23 @@ uint8_t InitInitSubHSM(void) {
 ES_Event RunInitSubHSM(ES_Event ThisEvent) {
     uint8_t makeTransition = FALSE; // use to flag transition
     TemplateSubHSMState_t nextState; // <- change type to correct enum
+    uint8_t recovery;
 
     ES_Tattle(); // trace call stack
 
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
+    }
+
+    if (ThisEvent.EventType == STATE_STALLED) {
+        recovery = HSM_StallRecovery(&Supervisor, ThisEvent);
+        if (recovery != STATE_STATS_NONE) {
+            nextState = recovery;
+            makeTransition = TRUE;
+            ThisEvent.EventType = ES_NO_EVENT;
+        }
+    }
+
     switch (CurrentState) {
         case InitPSubState: // If current state is initial Psedudo State
             if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
@@ -142,6 +169,7 @@ ES_Event RunInitSubHSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     ES_Timer_InitTimer(INIT_TIMER, INIT_DELAY_TIME);
+                    BootProfile_AwaitWarm();
                     break;
                 case ES_TIMEOUT:
                     if (ThisEvent.EventParam == INIT_TIMER) {
@@ -150,6 +178,13 @@ ES_Event RunInitSubHSM(ES_Event ThisEvent) {
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
                     break;
+                case SENSORS_WARM: // FAST_START only, the spin was waiting for them
+                    // its ES_TIMEOUT would land in the states after this one
+                    ES_Timer_StopTimer(INIT_TIMER);
+                    nextState = RadarState;
+                    makeTransition = TRUE;
+                    ThisEvent.EventType = ES_NO_EVENT;
+                    break;
                 case ES_NO_EVENT:
                 default:
                     BotTankTurnRight(SLOW_SPEED);
@@ -160,6 +195,7 @@ ES_Event RunInitSubHSM(ES_Event ThisEvent) {
         case RadarState:
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
+                    BootProfile_Mark(BOOT_RADAR);
                     break;
                 case BEACON_FOUND:
                     nextState = MoveInState;
@@ -179,10 +215,11 @@ ES_Event RunInitSubHSM(ES_Event ThisEvent) {
                     ES_Timer_InitTimer(INIT_TIMER, MOVE_TIME);
                     break;
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == INIT_TIMER)
+                    if (ThisEvent.EventParam == INIT_TIMER) {
                         nextState = TurnAroundState;
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
+                        makeTransition = TRUE;
+                        ThisEvent.EventType = ES_NO_EVENT;
+                    }
                     break;
                 case ES_NO_EVENT:
                 default: // all unhandled events pass the event back up to the next level
@@ -217,6 +254,7 @@ ES_Event RunInitSubHSM(ES_Event ThisEvent) {
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
         RunInitSubHSM(EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
         CurrentState = nextState;
         RunInitSubHSM(ENTRY_EVENT); // <- rename to your own Run function
     }
@@ -37,6 +37,11 @@ extern "C" {
 #define MID_RIGHT_TAPE_SENSOR_PIN AD_PORTW5
 #define FAR_RIGHT_TAPE_SENSOR_PIN AD_PORTW6
 #define FLASH_PIN PORTW,PIN7 
+    // Tape channels in array order and the status bit each sets on black,
+    // add a pin and a mask here to grow the array
+#define NUM_TAPE_SENSORS 4
+#define TAPE_SENSOR_PIN_LIST {FAR_LEFT_TAPE_SENSOR_PIN, MID_LEFT_TAPE_SENSOR_PIN, MID_RIGHT_TAPE_SENSOR_PIN, FAR_RIGHT_TAPE_SENSOR_PIN}
+#define TAPE_SENSOR_MASK_LIST {0x1000, 0x0100, 0x0010, 0x0001}
     // Servo Pins
 #define SERVO_0_OUT_PIN RC_PORTY06
 #define SERVO_1_OUT_PIN RC_PORTY07
@@ -0,0 +1,94 @@
+/*
+ * File:   ReadySet.h
+ *
+ * A set of up to 32 ready priorities in one word, bit n set when priority n
+ * has work. The highest ready priority is found with a single count leading
+ * zeros: on the PIC32 __builtin_clz() is the MIPS32 clz instruction, so the
+ * lookup costs the same at 32 priorities as at 8, where a table lookup has to
+ * walk the set a nibble or a byte at a time.
+ *
+ * ReadySet_HighestPortable() is the fallback for compilers without the
+ * builtin (define READY_SET_PORTABLE to force it); it is a fixed five step
+ * binary search. Both build on the host, Bench.c measures them against the
+ * table lookup.
+ *
+ * The macros are plain read-modify-writes of the word, with no locking. A set
+ * that is changed from more than one interrupt level must be changed with
+ * interrupts off. SensorTier's pending set is one of these: the IPL3 tick adds
+ * to it, and nothing that touches the set can preempt the tick. Everywhere
+ * else, SensorTier_Pend() and the IPL2 actor handler, interrupts are disabled
+ * around the change. ServiceHost's set is only changed from the ES_Run loop.
+ */
+
+#ifndef READYSET_H
+#define	READYSET_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define READY_SET_SIZE 32
+
+#define ReadySet_Add(set, priority) ((set) |= (ReadySet_t) 1 << (priority))
+#define ReadySet_Remove(set, priority) ((set) &= ~((ReadySet_t) 1 << (priority)))
+#define ReadySet_Contains(set, priority) (((set) >> (priority)) & 0x01)
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef uint32_t ReadySet_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+/**
+ * @Function ReadySet_HighestPortable(ReadySet_t set)
+ * @param set - must not be empty
+ * @return the highest priority in the set
+ * @brief Binary search for the top set bit, no builtins. */
+static inline uint8_t ReadySet_HighestPortable(ReadySet_t set) {
+    uint8_t highest = 0;
+
+    if (set & 0xFFFF0000) {
+        set >>= 16;
+        highest += 16;
+    }
+    if (set & 0xFF00) {
+        set >>= 8;
+        highest += 8;
+    }
+    if (set & 0xF0) {
+        set >>= 4;
+        highest += 4;
+    }
+    if (set & 0x0C) {
+        set >>= 2;
+        highest += 2;
+    }
+    return highest + (uint8_t) ((set >> 1) & 0x01);
+}
+
+/**
+ * @Function ReadySet_Highest(ReadySet_t set)
+ * @param set - must not be empty, clz of 0 is undefined
+ * @return the highest priority in the set
+ * @brief One clz where the compiler has it. */
+static inline uint8_t ReadySet_Highest(ReadySet_t set) {
+#if defined(__GNUC__) && !defined(READY_SET_PORTABLE)
+    return (READY_SET_SIZE - 1) - __builtin_clz(set);
+#else
+    return ReadySet_HighestPortable(set);
+#endif
+}
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* READYSET_H */
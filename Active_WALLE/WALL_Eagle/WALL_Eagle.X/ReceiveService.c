@@ -34,7 +34,14 @@
 #include "timers.h"
 #include "ReceiveService.h"
 #include "stdio.h"
+#include "SerialTx.h"
 #include "BumperService.h"
+#include "WorldState.h"
+#include "StateStats.h"
+#include "HSMDefer.h"
+#include "SensorRate.h"
+#include "HSMSupervisor.h"
+#include "motors.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -69,7 +76,7 @@ typedef enum {
     RamState3,
 } BumperResState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"HitThatShit",
 	"BackUpState",
@@ -100,7 +107,23 @@ static const char *StateNames[] = {
  * The type of state variable should match that of enum in header file. */
 
 static BumperResState_t CurrentState = InitPSubState; // <- change name to match ENUM
+STATE_STATS(Stats, "ReceiveService", StateNames);
+// missed the wire going in: back off and come in again; lost it lining up:
+// ram from where we are
+static const DwellLimit_t DwellLimits[] = {
+    {DriveInState, ATTEMPT_TIME, BackUpState},
+    {RealignState, RAM_TIME, RamState1},
+};
+HSM_SUPERVISOR(Supervisor, Stats, DwellLimits);
 static uint8_t MyPriority;
+static DeferQueue_t Deferred;
+// lining up on the track wire, the tape and the beacon are of no use here
+static const SensorRate_t TrackWireSensing = {{
+    [SENSOR_TAPE] = SENSOR_OFF,
+    [SENSOR_TRACK_WIRE] = SENSOR_EVERY_FRAME,
+    [SENSOR_BUMPER] = 25,
+    [SENSOR_BEACON] = SENSOR_OFF,
+}};
 
 uint8_t last_bump_received = 0;
 
@@ -124,6 +147,9 @@ uint8_t InitReceiveService(uint8_t last_bump) {
     ES_Event returnEvent;
     //TIMERS_Init();
     CurrentState = InitPSubState;
+    StateStats_Enter(&Stats, CurrentState);
+    HSM_Supervise(&Supervisor);
+    HSM_FlushDeferred(&Deferred);
     returnEvent = RunReceiveService(INIT_EVENT);
     //ES_Timer_InitTimer(RECEIVE_TIMEOUT_TIMER, 10000);
     if (returnEvent.EventType == ES_NO_EVENT) {
@@ -150,9 +176,23 @@ uint8_t InitReceiveService(uint8_t last_bump) {
 ES_Event RunReceiveService(ES_Event ThisEvent) {
     uint8_t makeTransition = FALSE; // use to flag transition
     BumperResState_t nextState; // <- change type to correct enum
+    uint8_t recovery;
 
     ES_Tattle(); // trace call stack
 
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
+    }
+
+    if (ThisEvent.EventType == STATE_STALLED) {
+        recovery = HSM_StallRecovery(&Supervisor, ThisEvent);
+        if (recovery != STATE_STATS_NONE) {
+            nextState = recovery;
+            makeTransition = TRUE;
+            ThisEvent.EventType = ES_NO_EVENT;
+        }
+    }
+
     switch (CurrentState) {
         case InitPSubState: // If current state is initial Psedudo State
             if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
@@ -174,7 +214,7 @@ ES_Event RunReceiveService(ES_Event ThisEvent) {
                     ES_Timer_InitTimer(RECEIVE_TIMER, 1500);
                     break;
                 case BUMPER_TRIPPED:
-                    last_bump_received = ThisEvent.EventParam;
+                    last_bump_received = WorldState_LastBump();
                     nextState = BackUpState;
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
@@ -206,6 +246,11 @@ ES_Event RunReceiveService(ES_Event ThisEvent) {
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
                     break;
+                case TRACK_WIRE_FOUND:
+                    // DriveInState acts on it
+                    HSM_Defer(&Deferred, ThisEvent);
+                    ThisEvent.EventType = ES_NO_EVENT;
+                    break;
                 default: // all unhandled events pass the event back up to the next level
                     BotMoveBackward(FAST_SPEED);
                     break;
@@ -224,6 +269,11 @@ ES_Event RunReceiveService(ES_Event ThisEvent) {
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
                     break;
+                case TRACK_WIRE_FOUND:
+                    // DriveInState acts on it
+                    HSM_Defer(&Deferred, ThisEvent);
+                    ThisEvent.EventType = ES_NO_EVENT;
+                    break;
                 default: // all unhandled events pass the event back up to the next level
                     if (last_bump_received == LEFT_HIT) BotTankTurnRight(SLOW_SPEED);
                     if (last_bump_received == RIGHT_HIT) BotTankTurnLeft(SLOW_SPEED);
@@ -233,10 +283,13 @@ ES_Event RunReceiveService(ES_Event ThisEvent) {
         case DriveInState:
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    ES_Timer_InitTimer(RECEIVE_TIMER, ATTEMPT_TIME);
+                    SensorRate_Declare(&TrackWireSensing);
+                    break;
+                case ES_EXIT:
+                    SensorRate_Default();
                     break;
                 case TRACK_WIRE_FOUND:
-                    if (ThisEvent.EventParam & 0x10) {
+                    if (WorldState_TrackWire() & TW_DETECTOR_1_MASK) {
                         nextState = RealignState;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -248,10 +301,10 @@ ES_Event RunReceiveService(ES_Event ThisEvent) {
             }
             break;
         case RealignState: // in the first state, replace this with correct names
-            printf("\n<<3>>\n");
+            SerialTx_Printf("\n<<3>>\n");
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    ES_Timer_InitTimer(RECEIVE_TIMER, RAM_TIME);
+                    SensorRate_Declare(&TrackWireSensing);
                     if (last_bump_received == LEFT_HIT) {
                         BotTankTurnRight(SLOW_SPEED);
                     }
@@ -260,8 +313,11 @@ ES_Event RunReceiveService(ES_Event ThisEvent) {
                     }
                     //BotMoveBackward(LUDACROUS_SPEED);
                     break;
+                case ES_EXIT:
+                    SensorRate_Default();
+                    break;
                 case TRACK_WIRE_FOUND:
-                    if (ThisEvent.EventParam & 0x01) {
+                    if (WorldState_TrackWire() & TW_DETECTOR_0_MASK) {
                         nextState = RamState1;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -373,8 +429,10 @@ ES_Event RunReceiveService(ES_Event ThisEvent) {
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
         RunReceiveService(EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
         CurrentState = nextState;
         RunReceiveService(ENTRY_EVENT); // <- rename to your own Run function
+        HSM_Recall(&Deferred);
     }
 
     ES_Tail(); // trace call stack end
@@ -35,6 +35,9 @@
 #include "TapeFollowSM.h"
 #include "BumpResService.h"
 #include "ReceiveService.h"
+#include "WorldState.h"
+#include "StateStats.h"
+#include "motors.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -52,7 +55,7 @@ typedef enum {
     ReceiveState,
 } ReloadSubHSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"WanderingState",
 	"RadarState",
@@ -77,10 +80,14 @@ static const char *StateNames[] = {
  * The type of state variable should match that of enum in header file. */
 
 static ReloadSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
+STATE_STATS(Stats, "ReloadSubHSM", StateNames);
 static uint8_t MyPriority;
+// own instances, the other parents keep theirs
+static TapeFollowSM_t TapeFollow = TAPE_FOLLOW_SM(TAPE_FOLLOW_TIMER, TAPE_FOLLOW_STARTUP_TIMER);
+static BumpResService_t BumpRes = BUMP_RES_SERVICE(BUMP_RES_TIMER);
+// state a bump interrupted, BUMP_RESOLVED returns there
+static ReloadSubHSMState_t HistoryState = TapeFollowingState;
 
-uint8_t last_bump = 0;
-uint8_t last_tw = 0;
 
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
@@ -100,6 +107,8 @@ uint8_t InitReloadSubHSM(void) {
     ES_Event returnEvent;
 
     CurrentState = InitPSubState;
+    HistoryState = TapeFollowingState;
+    StateStats_Enter(&Stats, CurrentState);
     returnEvent = RunReloadSubHSM(INIT_EVENT);
     if (returnEvent.EventType == ES_NO_EVENT) {
         return TRUE;
@@ -107,6 +116,26 @@ uint8_t InitReloadSubHSM(void) {
     return FALSE;
 }
 
+/**
+ * @Function ResumeReloadSubHSM(HistoryMode_t mode)
+ * @param mode - HISTORY_NONE restarts from the initial pseudo-state,
+ *               HISTORY_SHALLOW or HISTORY_DEEP re-enter the last active state
+ * @return TRUE or FALSE
+ * @brief Called by the parent state's entry action. A machine that was never
+ *        started is always restarted. */
+uint8_t ResumeReloadSubHSM(HistoryMode_t mode) {
+    HistoryMode_t previous;
+
+    if (mode == HISTORY_NONE || CurrentState == InitPSubState) {
+        return InitReloadSubHSM();
+    }
+    StateStats_Enter(&Stats, CurrentState);
+    previous = HSM_BeginResume(mode);
+    RunReloadSubHSM(ENTRY_EVENT);
+    HSM_EndResume(previous);
+    return TRUE;
+}
+
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
@@ -125,20 +154,12 @@ uint8_t InitReloadSubHSM(void) {
 ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
     uint8_t makeTransition = FALSE; // use to flag transition
     ReloadSubHSMState_t nextState; // <- change type to correct enum
+    HistoryMode_t history = HISTORY_NONE; // how nextState is entered
 
     ES_Tattle(); // trace call stack
 
-    // EVENT UPDATERS
-    switch (ThisEvent.EventType) {
-        case BUMPER_TRIPPED:
-            last_bump = ThisEvent.EventParam;
-            break;
-        case TRACK_WIRE_FOUND:
-            last_tw = ThisEvent.EventParam;
-            break;
-        case TRACK_WIRE_LOST:
-            last_tw = ThisEvent.EventParam;
-            break;
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
     }
 
     switch (CurrentState) {
@@ -148,9 +169,9 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
                 // this is where you would put any actions associated with the
                 // transition from the initial pseudo-state into the actual
                 // initial state
-                InitTapeFollowSM();
-                InitReceiveService(last_bump);
-                InitBumpResService(last_bump);
+                InitTapeFollowSM(&TapeFollow);
+                InitReceiveService(WorldState_LastBump());
+                InitBumpResService(&BumpRes, WorldState_LastBump());
                 // now put the machine into the actual initial state
                 nextState = TapeFollowingState;
                 makeTransition = TRUE;
@@ -167,6 +188,7 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
                     ThisEvent.EventType = ES_NO_EVENT;
                     break;
                 case BUMPER_TRIPPED:
+                    HistoryState = CurrentState;
                     nextState = BumpResState;
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
@@ -199,11 +221,13 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
             break;
 
         case TapeFollowingState: // in the first state, replace this with correct names
-            ThisEvent = RunTapeFollowSM(ThisEvent);
+            ThisEvent = RunTapeFollowSM(&TapeFollow, ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitTapeFollowSM();
-                    BotMoveForward(300);
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitTapeFollowSM(&TapeFollow);
+                        BotMoveForward(300);
+                    }
                     break;
                 case TRACK_WIRE_FOUND:
                     nextState = ReceiveState;
@@ -211,10 +235,10 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
                     ThisEvent.EventType = ES_NO_EVENT;
                     break;
                 case BUMPER_TRIPPED:
+                    HistoryState = CurrentState;
                     nextState = BumpResState;
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
-                    InitBumpResService(last_bump);
                     break;
                 case BEACON_FOUND:
                     nextState = RadarState;
@@ -228,10 +252,12 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
             break;
 
         case BumpResState: // in the first state, replace this with correct names
-            ThisEvent = RunBumpResService(ThisEvent);
+            ThisEvent = RunBumpResService(&BumpRes, ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitBumpResService(last_bump);
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitBumpResService(&BumpRes, WorldState_LastBump());
+                    }
                     break;
                 case TRACK_WIRE_FOUND:
                     nextState = ReceiveState;
@@ -239,7 +265,9 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
                     ThisEvent.EventType = ES_NO_EVENT;
                     break;
                 case BUMP_RESOLVED:
-                    nextState = TapeFollowingState;
+                    // pick up where the bump interrupted
+                    nextState = HistoryState;
+                    history = HISTORY_DEEP;
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
                     break;
@@ -266,7 +294,9 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
             ThisEvent = RunReceiveService(ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitReceiveService(last_bump);
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitReceiveService(WorldState_LastBump());
+                    }
                     break;
                 case AMMO_PLUNGER_LOST:
                     nextState = TapeFollowingState;
@@ -286,8 +316,11 @@ ES_Event RunReloadSubHSM(ES_Event ThisEvent) {
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
         RunReloadSubHSM(EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
         CurrentState = nextState;
+        history = HSM_BeginResume(history);
         RunReloadSubHSM(ENTRY_EVENT); // <- rename to your own Run function
+        HSM_EndResume(history);
     }
 
     ES_Tail(); // trace call stack end
@@ -26,6 +26,7 @@
  ******************************************************************************/
 
 #include "ES_Configure.h"   // defines ES_Event, INIT_EVENT, ENTRY_EVENT, and EXIT_EVENT
+#include "HSMHistory.h"
 
 /*******************************************************************************
  * PUBLIC #DEFINES                                                             *
@@ -53,6 +54,15 @@
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitReloadSubHSM(void);
 
+/**
+ * @Function ResumeReloadSubHSM(HistoryMode_t mode)
+ * @param mode - HISTORY_NONE restarts from the initial pseudo-state,
+ *               HISTORY_SHALLOW or HISTORY_DEEP re-enter the last active state
+ * @return TRUE or FALSE
+ * @brief Restarts or resumes the machine, see HSMHistory.h. A machine that
+ *        was never started is always restarted. */
+uint8_t ResumeReloadSubHSM(HistoryMode_t mode);
+
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
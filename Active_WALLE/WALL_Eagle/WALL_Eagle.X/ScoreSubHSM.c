@@ -37,6 +37,11 @@
 #include "DepositBallsSM.h"
 #include "ExclusionRadar.h"
 #include "BumpResService.h"
+#include "WorldState.h"
+#include "StateStats.h"
+#include "HSMDefer.h"
+#include "SensorRate.h"
+#include "HSMSupervisor.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -47,6 +52,7 @@
 #define TURN_AROUND_TIME 1950
 #define DETACH_TIME 2000
 #define MINI_SWEEP_TIME 400
+#define RADAR_TIMEOUT 10000 // more than a full turn at SEARCH_SPEED
 
 
 #define FAST_SPEED 500
@@ -71,7 +77,7 @@ typedef enum {
     BumpResState,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"MoveCenterState",
 	"RadarState",
@@ -104,11 +110,27 @@ static const char *StateNames[] = {
  * The type of state variable should match that of enum in header file. */
 
 static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
+STATE_STATS(Stats, "ScoreSubHSM", StateNames);
+// no beacon in a full turn, drive on and look again from there
+static const DwellLimit_t DwellLimits[] = {
+    {RadarState, RADAR_TIMEOUT, MoveCenterState},
+};
+HSM_SUPERVISOR(Supervisor, Stats, DwellLimits);
 static uint8_t MyPriority;
+// own instances, the other parents keep theirs
+static BumpResService_t BumpRes = BUMP_RES_SERVICE(BUMP_RES_TIMER);
+// state a bump interrupted, BUMP_RESOLVED returns there
+static TemplateSubHSMState_t HistoryState = MoveCenterState;
+static DeferQueue_t Deferred;
+// sweeping for the beacon, nothing but the beacon and the bumpers matters
+static const SensorRate_t RadarSensing = {{
+    [SENSOR_TAPE] = SENSOR_OFF,
+    [SENSOR_TRACK_WIRE] = SENSOR_OFF,
+    [SENSOR_BUMPER] = 25,
+    [SENSOR_BEACON] = SENSOR_EVERY_FRAME,
+}};
 
-uint8_t numtapes = 0;
 int sweep_time = MINI_SWEEP_TIME;
-uint8_t last_bump_in = 0;
 
 
 /*******************************************************************************
@@ -129,6 +151,10 @@ uint8_t InitScoreSubHSM(void) {
     ES_Event returnEvent;
 
     CurrentState = InitPSubState;
+    HistoryState = MoveCenterState;
+    StateStats_Enter(&Stats, CurrentState);
+    HSM_Supervise(&Supervisor);
+    HSM_FlushDeferred(&Deferred);
     returnEvent = RunScoreSubHSM(INIT_EVENT);
     if (returnEvent.EventType == ES_NO_EVENT) {
         return TRUE;
@@ -136,6 +162,26 @@ uint8_t InitScoreSubHSM(void) {
     return FALSE;
 }
 
+/**
+ * @Function ResumeScoreSubHSM(HistoryMode_t mode)
+ * @param mode - HISTORY_NONE restarts from the initial pseudo-state,
+ *               HISTORY_SHALLOW or HISTORY_DEEP re-enter the last active state
+ * @return TRUE or FALSE
+ * @brief Called by the parent state's entry action. A machine that was never
+ *        started is always restarted. */
+uint8_t ResumeScoreSubHSM(HistoryMode_t mode) {
+    HistoryMode_t previous;
+
+    if (mode == HISTORY_NONE || CurrentState == InitPSubState) {
+        return InitScoreSubHSM();
+    }
+    StateStats_Enter(&Stats, CurrentState);
+    previous = HSM_BeginResume(mode);
+    RunScoreSubHSM(ENTRY_EVENT);
+    HSM_EndResume(previous);
+    return TRUE;
+}
+
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
@@ -154,18 +200,32 @@ uint8_t InitScoreSubHSM(void) {
 ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
     uint8_t makeTransition = FALSE; // use to flag transition
     TemplateSubHSMState_t nextState; // <- change type to correct enum
+    HistoryMode_t history = HISTORY_NONE; // how nextState is entered
+    uint8_t recovery;
 
     ES_Tattle(); // trace call stack
 
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
+    }
+
     switch (ThisEvent.EventType) {
-        case TAPE_SENSOR_TRIPPED:
-            numtapes = NumTapesTripped(ThisEvent.EventParam);
-            break;
         case BUMPER_TRIPPED:
-            last_bump_in = ThisEvent.EventParam;
+            if (CurrentState != BumpResState && CurrentState != InitPSubState) {
+                HistoryState = CurrentState;
+            }
             nextState = BumpResState;
             makeTransition = TRUE;
             ThisEvent.EventType = ES_NO_EVENT;
+            break;
+        case STATE_STALLED:
+            recovery = HSM_StallRecovery(&Supervisor, ThisEvent);
+            if (recovery != STATE_STATS_NONE) {
+                nextState = recovery;
+                makeTransition = TRUE;
+                ThisEvent.EventType = ES_NO_EVENT;
+            }
+            break;
     }
 
     switch (CurrentState) {
@@ -195,6 +255,12 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
                     break;
+                case BEACON_FOUND:
+                case BEACON_LOST:
+                    // RadarState acts on them, both kept so a lost beacon is not zoned in on
+                    HSM_Defer(&Deferred, ThisEvent);
+                    ThisEvent.EventType = ES_NO_EVENT;
+                    break;
                 case ES_NO_EVENT:
                 default: // all unhandled events pass the event back up to the next level
                     BotMoveForward(FAST_SPEED);
@@ -205,8 +271,12 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
         case RadarState:
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
+                    SensorRate_Declare(&RadarSensing);
                     BotTankTurnLeft(SEARCH_SPEED);
                     break;
+                case ES_EXIT:
+                    SensorRate_Default();
+                    break;
                 case BEACON_FOUND:
                     nextState = ZoneInState;
                     makeTransition = TRUE;
@@ -222,9 +292,13 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
         case MiniRadarState0:
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
+                    SensorRate_Declare(&RadarSensing);
                     BotTankTurnLeft(SEARCH_SPEED);
                     ES_Timer_InitTimer(SCORE_TIMER, sweep_time);
                     break;
+                case ES_EXIT:
+                    SensorRate_Default();
+                    break;
                 case BEACON_FOUND:
                     nextState = ZoneInState;
                     makeTransition = TRUE;
@@ -247,10 +321,16 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
         case MiniRadarState1:
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
+                    SensorRate_Declare(&RadarSensing);
                     BotTankTurnRight(SEARCH_SPEED);
-                    sweep_time *= 2;
+                    if (HSM_ResumeMode() == HISTORY_NONE) {
+                        sweep_time *= 2;
+                    }
                     ES_Timer_InitTimer(SCORE_TIMER, sweep_time);
                     break;
+                case ES_EXIT:
+                    SensorRate_Default();
+                    break;
                 case BEACON_FOUND:
                     nextState = ZoneInState;
                     makeTransition = TRUE;
@@ -282,7 +362,7 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
                     sweep_time = MINI_SWEEP_TIME;
                     break;
                 case TAPE_SENSOR_TRIPPED:
-                    if (ThisEvent.EventParam & 0x1000 && ThisEvent.EventParam & 0x0001) {
+                    if (WorldState_TapeOn(0x1000) && WorldState_TapeOn(0x0001)) {
                         nextState = BackUpState;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -349,7 +429,9 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     BotHalt();
-                    InitDepositBallsSM();
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitDepositBallsSM();
+                    }
                     break;
                 case BALL_DROPPED:
                     nextState = DropBallAgainState;
@@ -367,7 +449,9 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     BotHalt();
-                    InitDepositBallsSM();
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitDepositBallsSM();
+                    }
                     break;
                 case BALL_DROPPED:
                     nextState = DetachState;
@@ -401,7 +485,9 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
             ThisEvent = RunExclusionRadar(ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitExclusionRadar();
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitExclusionRadar();
+                    }
                     break;
                 case BEACON_FOUND:
                     nextState = ZoneInState;
@@ -415,13 +501,17 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
             break;
 
         case BumpResState: // in the first state, replace this with correct names
-            ThisEvent = RunBumpResService(ThisEvent);
+            ThisEvent = RunBumpResService(&BumpRes, ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitBumpResService(last_bump_in);
+                    if (HSM_ResumeMode() != HISTORY_DEEP) {
+                        InitBumpResService(&BumpRes, WorldState_LastBump());
+                    }
                     break;
                 case BUMP_RESOLVED:
-                    nextState = MoveCenterState;
+                    // pick up where the bump interrupted
+                    nextState = HistoryState;
+                    history = HISTORY_DEEP;
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
                     break;
@@ -438,8 +528,12 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
         RunScoreSubHSM(EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
         CurrentState = nextState;
+        history = HSM_BeginResume(history);
         RunScoreSubHSM(ENTRY_EVENT); // <- rename to your own Run function
+        HSM_EndResume(history);
+        HSM_Recall(&Deferred);
     }
 
     ES_Tail(); // trace call stack end
@@ -449,11 +543,3 @@ ES_Event RunScoreSubHSM(ES_Event ThisEvent) {
 /*******************************************************************************
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
-uint8_t NumTapesTripped(uint16_t param) {
-    uint8_t num = 0;
-    if (param & (0x0001)) num++;
-    if (param & (0x0010)) num++;
-    if (param & (0x0100)) num++;
-    if (param & (0x1000)) num++;
-    return num;
-}
@@ -0,0 +1,90 @@
+/*
+ * File:   SensorRate.c
+ *
+ * Per state sample periods and AD channel enables, see SensorRate.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "AD.h"
+#include "PinsMaster.h"
+#include "SensorRate.h"
+#include "SensorTier.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define TAPE_PINS (FAR_LEFT_TAPE_SENSOR_PIN | MID_LEFT_TAPE_SENSOR_PIN | \
+                   MID_RIGHT_TAPE_SENSOR_PIN | FAR_RIGHT_TAPE_SENSOR_PIN)
+
+// what the sensors ran at before the scheduler, every group on, except the
+// beacon: its detector output is filtered and moves over tens of ms, only the
+// radar sweeps want it on every frame
+#define DEFAULT_RATES {{ \
+        [SENSOR_TAPE] = 2, \
+        [SENSOR_TRACK_WIRE] = 5, \
+        [SENSOR_BUMPER] = 25, \
+        [SENSOR_BEACON] = 10, \
+    }}
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static const SensorRate_t DefaultRates = DEFAULT_RATES;
+
+static const uint32_t sensor_pins[NUM_SENSORS] = {
+    [SENSOR_TAPE] = TAPE_PINS,
+    [SENSOR_TRACK_WIRE] = TW_DETECTOR_0_PIN | TW_DETECTOR_1_PIN,
+    [SENSOR_BUMPER] = LEFT_BUMPER_PIN | RIGHT_BUMPER_PIN,
+    [SENSOR_BEACON] = BEACON_DETECTOR_PIN,
+};
+
+static SensorRate_t current = DEFAULT_RATES;
+static uint32_t last_sample[NUM_SENSORS];
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void SensorRate_Declare(const SensorRate_t *rates) {
+    uint32_t add = 0, remove = 0;
+    uint8_t i;
+
+    for (i = 0; i < NUM_SENSORS; i++) {
+        if (rates->period[i] != SENSOR_OFF && current.period[i] == SENSOR_OFF) {
+            add |= sensor_pins[i];
+        } else if (rates->period[i] == SENSOR_OFF && current.period[i] != SENSOR_OFF) {
+            remove |= sensor_pins[i];
+        }
+    }
+    // reconfiguring the AD scan is not free, only do it for real changes. The
+    // acquire actor reads the scan and the tape actor the rates, keep them out
+    SensorTier_Lock();
+    if (remove) AD_RemovePins(remove);
+    if (add) AD_AddPins(add);
+    current = *rates;
+    SensorTier_Unlock();
+}
+
+void SensorRate_Default(void) {
+    SensorRate_Declare(&DefaultRates);
+}
+
+uint8_t SensorRate_Due(Sensor_t sensor) {
+    uint32_t now;
+
+    if (current.period[sensor] == SENSOR_OFF) return FALSE;
+    now = ES_Timer_GetTime();
+    if (now - last_sample[sensor] < current.period[sensor]) return FALSE;
+    last_sample[sensor] = now;
+    return TRUE;
+}
+
+uint16_t SensorRate_Period(Sensor_t sensor) {
+    return current.period[sensor];
+}
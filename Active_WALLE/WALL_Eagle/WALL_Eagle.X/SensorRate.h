@@ -0,0 +1,87 @@
+/*
+ * File:   SensorRate.h
+ *
+ * Sensing scheduler. Every sensor group gets a sample period in ms that the
+ * current state picks: a state that needs something other than the default
+ * declares a SensorRate_t next to its machine and applies it on ES_ENTRY,
+ * and goes back to the default on ES_EXIT:
+ *
+ *   static const SensorRate_t RadarSensing = {{
+ *       [SENSOR_TAPE] = SENSOR_OFF, ...
+ *   }};
+ *
+ *   case ES_ENTRY: SensorRate_Declare(&RadarSensing); break;
+ *   case ES_EXIT:  SensorRate_Default(); break;
+ *
+ * The sensor services ask SensorRate_Due() before they process an AD frame,
+ * so a slow sensor costs nothing in between. A group that goes to SENSOR_OFF
+ * also has its AD channels taken out of the scan, which shortens the scan for
+ * the groups still running; its last readings stay in the AD frames.
+ */
+
+#ifndef SENSORRATE_H
+#define	SENSORRATE_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define SENSOR_OFF 0            // not sampled, AD channels disabled
+#define SENSOR_EVERY_FRAME 1    // every AD frame (faster than 1 ms is not asked for)
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef enum {
+    SENSOR_TAPE,
+    SENSOR_TRACK_WIRE,
+    SENSOR_BUMPER,
+    SENSOR_BEACON,
+    NUM_SENSORS,
+} Sensor_t;
+
+typedef struct {
+    uint16_t period[NUM_SENSORS];   // ms between samples, SENSOR_OFF to stop
+} SensorRate_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function SensorRate_Declare(const SensorRate_t *rates)
+ * @param rates - periods for the state being entered
+ * @return None
+ * @brief Switches the AD channels of groups turning on or off and starts
+ *        using the new periods. */
+void SensorRate_Declare(const SensorRate_t *rates);
+
+/**
+ * @Function SensorRate_Default(void)
+ * @return None
+ * @brief Declares the default rates, the ones every state without a
+ *        declaration of its own runs with. */
+void SensorRate_Default(void);
+
+/**
+ * @Function SensorRate_Due(Sensor_t sensor)
+ * @param sensor - the group about to be sampled
+ * @return TRUE if the group's period has passed since it last returned TRUE,
+ *         FALSE if not or if the group is off */
+uint8_t SensorRate_Due(Sensor_t sensor);
+
+/**
+ * @Function SensorRate_Period(Sensor_t sensor)
+ * @return the group's current period, SENSOR_OFF if it is off */
+uint16_t SensorRate_Period(Sensor_t sensor);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SENSORRATE_H */
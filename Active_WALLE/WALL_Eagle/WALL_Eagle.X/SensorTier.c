@@ -0,0 +1,222 @@
+/*
+ * File:   SensorTier.c
+ *
+ * Tick, actor dispatch and hand-over to the loop, see SensorTier.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <xc.h>
+#include <sys/attribs.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "ReadySet.h"
+#include "ADFrame.h"
+#include "TapeSensorService.h"
+#include "SensorTier.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define TICKS_PER_US (80 / 2)   // the core timer counts every other SYSCLK
+#define SlotOf(index) ((index) & (SENSOR_TIER_HANDOVER - 1))
+#define TIER_INTERRUPTS (_IEC0_CTIE_MASK | _IEC0_CS0IE_MASK)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+typedef struct {
+    uint32_t runs;
+    uint32_t total;     // core timer ticks, tick to start
+    uint32_t max;
+} Jitter_t;
+
+typedef struct {
+    uint8_t(*post)(ES_Event);
+    ES_Event event;
+    uint32_t stamp;
+} Handover_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static void RunActors(void);
+static void Account(Jitter_t *jitter, uint32_t ticks);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static void(* const Actors[NUM_TIER_ACTORS])(void) = {
+    [TIER_TAPE] = TapeSensor_Demodulate,
+    [TIER_ACQUIRE] = ADFrame_Capture,
+};
+
+static const char * const ActorNames[NUM_TIER_ACTORS] = {
+    [TIER_TAPE] = "tape",
+    [TIER_ACQUIRE] = "acquire",
+};
+
+static volatile ReadySet_t pending;
+#ifdef HIL_MODE
+static uint8_t running = FALSE;         // an actor pending another one inline
+#endif
+static volatile uint32_t tick_stamp;    // core timer at the latest tick
+static uint32_t actor_stamp;            // tick_stamp when the running actor started
+
+static Jitter_t actor_jitter[NUM_TIER_ACTORS];
+static Jitter_t handover_jitter;
+static uint16_t handover_dropped;
+
+static Handover_t handover[SENSOR_TIER_HANDOVER];
+static volatile uint8_t handover_head;  // written by the loop
+static volatile uint8_t handover_tail;  // written by the actors
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void SensorTier_Init(void) {
+#ifndef HIL_MODE
+    tick_stamp = _CP0_GET_COUNT();
+    _CP0_SET_COMPARE(tick_stamp + SENSOR_TIER_PERIOD);
+    IPC0bits.CTIP = 3;
+    IPC0bits.CS0IP = 2;
+    IFS0CLR = _IFS0_CTIF_MASK | _IFS0_CS0IF_MASK;
+    IEC0SET = TIER_INTERRUPTS;
+#endif
+}
+
+void SensorTier_Pend(TierActor_t actor) {
+    uint32_t int_status = __builtin_disable_interrupts();
+    ReadySet_Add(pending, actor);
+    if (int_status & 0x01) __builtin_enable_interrupts();
+#ifdef HIL_MODE
+    // no tick and no software interrupt, the loop is the tier
+    if (running) return;
+    running = TRUE;
+    tick_stamp = _CP0_GET_COUNT();
+    RunActors();
+    running = FALSE;
+#else
+    _CP0_BIS_CAUSE(_CP0_CAUSE_IP0_MASK);
+#endif
+}
+
+uint32_t SensorTier_Stamp(void) {
+    return actor_stamp;
+}
+
+uint8_t SensorTier_Post(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent) {
+    Handover_t *slot;
+
+    if ((uint8_t) (handover_tail - handover_head) == SENSOR_TIER_HANDOVER) {
+        if (handover_dropped < UINT16_MAX) handover_dropped++;
+        return FALSE;
+    }
+    slot = &handover[SlotOf(handover_tail)];
+    slot->post = PostFunction;
+    slot->event = ThisEvent;
+    slot->stamp = actor_stamp;
+    handover_tail++;    // publishes the slot
+    return TRUE;
+}
+
+uint8_t SensorTier_Deliver(void) {
+    Handover_t *slot;
+
+    if (handover_head == handover_tail) return FALSE;
+    slot = &handover[SlotOf(handover_head)];
+    Account(&handover_jitter, _CP0_GET_COUNT() - slot->stamp);
+    slot->post(slot->event);
+    handover_head++;    // frees the slot
+    return TRUE;
+}
+
+void SensorTier_Lock(void) {
+#ifndef HIL_MODE
+    IEC0CLR = TIER_INTERRUPTS;
+#endif
+}
+
+void SensorTier_Unlock(void) {
+#ifndef HIL_MODE
+    IEC0SET = TIER_INTERRUPTS;
+#endif
+}
+
+void SensorTier_Dump(void) {
+    const Jitter_t *jitter;
+    uint8_t i;
+
+    for (i = 0; i < NUM_TIER_ACTORS; i++) {
+        jitter = &actor_jitter[i];
+        printf("\r\nJ %s %lu %lu %lu", ActorNames[i], (unsigned long) jitter->runs,
+                (unsigned long) (jitter->runs ? jitter->total / jitter->runs / TICKS_PER_US : 0),
+                (unsigned long) (jitter->max / TICKS_PER_US));
+    }
+    jitter = &handover_jitter;
+    printf("\r\nJ handover %lu %u %lu %lu", (unsigned long) jitter->runs, handover_dropped,
+            (unsigned long) (jitter->runs ? jitter->total / jitter->runs / TICKS_PER_US : 0),
+            (unsigned long) (jitter->max / TICKS_PER_US));
+}
+
+#ifndef HIL_MODE
+
+void __ISR(_CORE_TIMER_VECTOR, IPL3AUTO) SensorTierTick(void) {
+    uint32_t due = _CP0_GET_COMPARE();
+    uint32_t next = due + SENSOR_TIER_PERIOD;
+
+    // stay on the grid if this one was late, unless it missed a whole period
+    // (the compare would then not match again for 107 s)
+    if ((int32_t) (next - _CP0_GET_COUNT()) <= 0) next = _CP0_GET_COUNT() + SENSOR_TIER_PERIOD;
+    _CP0_SET_COMPARE(next);
+    IFS0CLR = _IFS0_CTIF_MASK;
+    tick_stamp = due;
+    ReadySet_Add(pending, TIER_ACQUIRE);
+    _CP0_BIS_CAUSE(_CP0_CAUSE_IP0_MASK);
+}
+
+void __ISR(_CORE_SOFTWARE_0_VECTOR, IPL2AUTO) SensorTierActors(void) {
+    _CP0_BIC_CAUSE(_CP0_CAUSE_IP0_MASK);
+    IFS0CLR = _IFS0_CS0IF_MASK;
+    RunActors();
+}
+
+#endif
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// Runs pending actors, highest first, until none is left. The tick can add
+// one at any time, so the set is only changed with interrupts off.
+static void RunActors(void) {
+    uint32_t int_status;
+    uint8_t actor;
+
+    for (;;) {
+        int_status = __builtin_disable_interrupts();
+        if (pending == 0) {
+            if (int_status & 0x01) __builtin_enable_interrupts();
+            return;
+        }
+        actor = ReadySet_Highest(pending);
+        ReadySet_Remove(pending, actor);
+        actor_stamp = tick_stamp;
+        if (int_status & 0x01) __builtin_enable_interrupts();
+
+        Account(&actor_jitter[actor], _CP0_GET_COUNT() - actor_stamp);
+        Actors[actor]();
+    }
+}
+
+static void Account(Jitter_t *jitter, uint32_t ticks) {
+    if (jitter->runs == UINT32_MAX || jitter->total > UINT32_MAX - ticks) return;
+    jitter->runs++;
+    jitter->total += ticks;
+    if (ticks > jitter->max) jitter->max = ticks;
+}
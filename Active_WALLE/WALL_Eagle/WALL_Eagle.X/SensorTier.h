@@ -0,0 +1,124 @@
+/*
+ * File:   SensorTier.h
+ *
+ * The interrupt level tier under the cooperative ES_Run loop. Sensor
+ * acquisition and tape demodulation used to wait their turn behind whatever
+ * TopHSM was doing (a recursive transition, InitTapeFollowSM and a trace line
+ * could hold the loop for milliseconds), which stretched the flash on and
+ * flash off phases by as much. They now run as short run-to-completion
+ * actors that preempt the loop; the state machines stay in it.
+ *
+ * A core timer compare interrupt (IPL3) fires every SENSOR_TIER_PERIOD,
+ * stamps the tick and pends TIER_ACQUIRE. Pending actors run from the core
+ * software interrupt 0 handler (IPL2), highest actor first (ReadySet.h),
+ * each to completion; an actor can pend a lower one, which runs straight
+ * after it. Both levels are below the framework's own timer, AD and UART
+ * interrupts, which keep preempting the actors as they always have.
+ *
+ *   TIER_ACQUIRE  ADFrame_Capture(): takes a finished AD scan into a frame
+ *                 and pends TIER_TAPE
+ *   TIER_TAPE     TapeSensor_Demodulate(): the flash on/off cycle and
+ *                 TapeFrame_Process()
+ *
+ * The framework queues are not interrupt safe, so actors never post. They
+ * hand events to SensorTier_Post(), a single producer ring that the
+ * CheckSensorTier event checker empties into the real post functions. Every
+ * handed over event carries the core timer stamp of the tick that acquired
+ * it, so the delay to the loop is measured as well.
+ *
+ * Jitter is kept per actor (tick to actor start) and for the hand-over (tick
+ * to post), SensorTier_Dump() prints it with the 's' stats dump in us:
+ *
+ *   J <actor> <runs> <mean> <max>
+ *   J handover <posted> <dropped> <mean> <max>
+ *
+ * Data shared between an actor and the loop is changed by the loop inside
+ * SensorTier_Lock()/SensorTier_Unlock(), which masks both tier interrupts.
+ *
+ * In HIL_MODE frames come in over the UART from the loop (HIL.h), so there
+ * is no tick: ADFrame_Publish() pends TIER_ACQUIRE itself and the actors run
+ * inline, the same code with the same accounting.
+ */
+
+#ifndef SENSORTIER_H
+#define	SENSORTIER_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define SENSOR_TIER_PERIOD 20000    // core timer ticks, 500 us at 40 MHz
+#define SENSOR_TIER_HANDOVER 8      // events in flight to the loop, a power of two
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef enum {
+    TIER_TAPE,      // lowest
+    TIER_ACQUIRE,
+    NUM_TIER_ACTORS,
+} TierActor_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function SensorTier_Init(void)
+ * @return None
+ * @brief Starts the tick, call once the services are initialised. */
+void SensorTier_Init(void);
+
+/**
+ * @Function SensorTier_Pend(TierActor_t actor)
+ * @return None
+ * @brief Marks actor to run at the next chance, from an actor or the tick. */
+void SensorTier_Pend(TierActor_t actor);
+
+/**
+ * @Function SensorTier_Stamp(void)
+ * @return core timer count of the tick the running actor belongs to
+ * @brief The acquisition time of whatever the actor is working on. */
+uint32_t SensorTier_Stamp(void);
+
+/**
+ * @Function SensorTier_Post(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent)
+ * @return TRUE, or FALSE if the hand-over ring is full (counted)
+ * @brief From an actor: PostFunction(ThisEvent) is called from the loop. */
+uint8_t SensorTier_Post(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent);
+
+/**
+ * @Function SensorTier_Deliver(void)
+ * @return TRUE if an event was posted
+ * @brief The event checker side of SensorTier_Post(), one event per call. */
+uint8_t SensorTier_Deliver(void);
+
+/**
+ * @Function SensorTier_Lock(void)
+ * @return None
+ * @brief Keeps the actors out until SensorTier_Unlock(), from the loop only. */
+void SensorTier_Lock(void);
+
+/**
+ * @Function SensorTier_Unlock(void)
+ * @return None
+ * @brief Lets the actors in again, anything that came due runs now. */
+void SensorTier_Unlock(void);
+
+/**
+ * @Function SensorTier_Dump(void)
+ * @return None
+ * @brief Prints the J lines. */
+void SensorTier_Dump(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SENSORTIER_H */
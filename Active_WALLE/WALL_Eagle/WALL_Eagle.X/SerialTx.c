@@ -0,0 +1,159 @@
+/*
+ * File:   SerialTx.c
+ *
+ * Drop-on-full serial output ring and formatter, see SerialTx.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "serial.h"
+#include "SerialTx.h"
+#include <stdarg.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define SlotOf(index) ((index) & (SERIAL_TX_RING_SIZE - 1))
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static uint8_t FormatNumber(char *out, uint8_t room, uint32_t value, uint8_t negative,
+        uint8_t base, const char *digits, uint8_t width, char pad);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static char ring[SERIAL_TX_RING_SIZE];
+static uint16_t head;       // next byte to hand to serial.c, free running
+static uint16_t tail;       // next free byte, free running
+static uint16_t dropped;
+
+static const char LowerDigits[] = "0123456789abcdef";
+static const char UpperDigits[] = "0123456789ABCDEF";
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t SerialTx_Write(const void *data, uint16_t length) {
+    const char *bytes = data;
+
+    if (length > SERIAL_TX_RING_SIZE - (uint16_t) (tail - head)) {
+        if (dropped < UINT16_MAX) dropped++;
+        return FALSE;
+    }
+    while (length--) {
+        ring[SlotOf(tail++)] = *bytes++;
+    }
+    return TRUE;
+}
+
+uint8_t SerialTx_Printf(const char *format, ...) {
+    char line[SERIAL_TX_LINE_SIZE];
+    uint8_t length = 0, width, is_long;
+    char pad;
+    const char *text;
+    int32_t number;
+    uint32_t value;
+    va_list args;
+
+    va_start(args, format);
+    for (; *format && length < sizeof (line) - 1; format++) {
+        if (*format != '%') {
+            line[length++] = *format;
+            continue;
+        }
+        format++;
+        pad = ' ';
+        if (*format == '0') {
+            pad = '0';
+            format++;
+        }
+        for (width = 0; *format >= '0' && *format <= '9'; format++) {
+            width = width * 10 + (*format - '0');
+        }
+        is_long = (*format == 'l');
+        if (is_long) format++;
+
+        switch (*format) {
+            case 's':
+                for (text = va_arg(args, const char *); *text && length < sizeof (line) - 1; text++) {
+                    line[length++] = *text;
+                }
+                break;
+            case 'c':
+                line[length++] = (char) va_arg(args, int);
+                break;
+            case 'd':
+                number = is_long ? va_arg(args, long) : va_arg(args, int);
+                length += FormatNumber(line + length, sizeof (line) - 1 - length,
+                        number < 0 ? -(uint32_t) number : (uint32_t) number, number < 0,
+                        10, LowerDigits, width, pad);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+                value = is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+                length += FormatNumber(line + length, sizeof (line) - 1 - length, value, FALSE,
+                        *format == 'u' ? 10 : 16, *format == 'X' ? UpperDigits : LowerDigits, width, pad);
+                break;
+            case '%':
+                line[length++] = '%';
+                break;
+            default:
+                // not supported, show where instead of guessing the argument
+                line[length++] = '?';
+                if (*format == '\0') format--;
+                break;
+        }
+    }
+    va_end(args);
+    return SerialTx_Write(line, length);
+}
+
+void SerialTx_Drain(void) {
+    uint8_t n;
+
+    if (head == tail || !IsTransmitEmpty()) return;
+    for (n = 0; n < SERIAL_TX_CHUNK && head != tail; n++) {
+        PutChar(ring[SlotOf(head++)]);
+    }
+}
+
+uint16_t SerialTx_Dropped(void) {
+    return dropped;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// writes value right aligned in width, returns the characters written
+static uint8_t FormatNumber(char *out, uint8_t room, uint32_t value, uint8_t negative,
+        uint8_t base, const char *digits, uint8_t width, char pad) {
+    char reversed[11];
+    uint8_t count = 0, length = 0;
+
+    do {
+        reversed[count++] = digits[value % base];
+        value /= base;
+    } while (value);
+    if (negative && pad == '0' && length < room) {
+        out[length++] = '-';
+        negative = FALSE;
+        if (width) width--;
+    }
+    while (width > count + negative && length < room) {
+        out[length++] = pad;
+        width--;
+    }
+    if (negative && length < room) out[length++] = '-';
+    while (count && length < room) {
+        out[length++] = reversed[--count];
+    }
+    return length;
+}
@@ -0,0 +1,74 @@
+/*
+ * File:   SerialTx.h
+ *
+ * Non-blocking serial output for the services. printf goes straight into
+ * serial.c's transmit FIFO and spins in PutChar() once that is full, which
+ * stalls the whole ES_Run loop (the tape cadence collapsed whenever the
+ * TopHSM trace was on).
+ *
+ * Output written here goes into a SERIAL_TX_RING_SIZE byte ring instead. A
+ * message that does not fit is dropped whole and counted, it never waits.
+ * The CheckSerialTx event checker hands the ring to serial.c
+ * SERIAL_TX_CHUNK bytes at a time, and only when serial.c's FIFO is empty,
+ * so PutChar() never has to wait either. The UART interrupt that finishes a
+ * chunk wakes the idle loop (Idle.h) to pass on the next one.
+ *
+ * SerialTx_Printf() is a small formatter for the trace lines, it handles
+ * %s %c %d %u %x %X and %% with an optional 0 flag, width and l modifier,
+ * nothing else, and formats at most SERIAL_TX_LINE_SIZE - 1 characters.
+ *
+ * printf is still fine for boot messages and the stats dump, but output from
+ * the two can interleave at chunk boundaries.
+ */
+
+#ifndef SERIALTX_H
+#define	SERIALTX_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define SERIAL_TX_RING_SIZE 1024    // a power of two
+#define SERIAL_TX_CHUNK 32          // bytes handed to serial.c at once, well under its FIFO
+#define SERIAL_TX_LINE_SIZE 96      // SerialTx_Printf() stack buffer
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function SerialTx_Write(const void *data, uint16_t length)
+ * @return TRUE, or FALSE if the ring had no room and nothing was written
+ * @brief Messages are never split, a packet or line goes out whole or not
+ *        at all. */
+uint8_t SerialTx_Write(const void *data, uint16_t length);
+
+/**
+ * @Function SerialTx_Printf(const char *format, ...)
+ * @return TRUE, or FALSE if the line was dropped
+ * @brief Formats into a line buffer and writes it, see above for the
+ *        conversions. */
+uint8_t SerialTx_Printf(const char *format, ...);
+
+/**
+ * @Function SerialTx_Drain(void)
+ * @return None
+ * @brief Passes the next chunk to serial.c if its FIFO is empty. */
+void SerialTx_Drain(void);
+
+/**
+ * @Function SerialTx_Dropped(void)
+ * @return messages dropped because the ring was full (saturates)
+ * @brief Printed with the 's' stats dump. */
+uint16_t SerialTx_Dropped(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SERIALTX_H */
@@ -0,0 +1,126 @@
+/*
+ * File:   ServiceHost.c
+ *
+ * Hosted services behind a 32 bit ready set, see ServiceHost.h. Nothing is
+ * compiled while ES_Spec.json lists no hosted service.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+
+#if NUM_HOSTED_SERVICES > 0
+
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "ReadySet.h"
+#include "ServiceHost.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#if NUM_HOSTED_SERVICES > READY_SET_SIZE
+#error "ServiceHost runs at most READY_SET_SIZE hosted services"
+#endif
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static uint8_t Wake(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static uint8_t MyPriority;
+static ReadySet_t Ready;
+static uint8_t Waking;  // a SERVICES_READY is in the host's queue
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t InitServiceHost(uint8_t Priority) {
+    uint8_t i;
+
+    MyPriority = Priority;
+    Ready = 0;
+    Waking = FALSE;
+    for (i = 0; i < NUM_HOSTED_SERVICES; i++) {
+        HostedServices[i].head = 0;
+        HostedServices[i].count = 0;
+        if (HostedServices[i].Init(i) != TRUE) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+uint8_t ServiceHost_Post(uint8_t Priority, ES_Event ThisEvent) {
+    HostedService_t *me = &HostedServices[Priority];
+    uint8_t slot;
+
+    if (me->count == me->size) return FALSE;
+    // a failed Wake() means the host's queue is full, its next run wakes it
+    Wake();
+    slot = me->head + me->count;
+    if (slot >= me->size) slot -= me->size;
+    me->queue[slot] = ThisEvent;
+    me->count++;
+    ReadySet_Add(Ready, Priority);
+    return TRUE;
+}
+
+uint8_t PostServiceHost(ES_Event ThisEvent) {
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+ES_Event RunServiceHost(ES_Event ThisEvent) {
+    ES_Event ReturnEvent;
+    HostedService_t *me;
+    uint8_t i;
+
+    ReturnEvent.EventType = ES_NO_EVENT;
+    if (ThisEvent.EventType != SERVICES_READY) {
+        for (i = 0; i < NUM_HOSTED_SERVICES; i++) {
+            ServiceHost_Post(i, ThisEvent);
+        }
+        if (Ready != 0) Wake(); // a turn lost to a full queue
+        return ReturnEvent;
+    }
+    Waking = FALSE;
+    if (Ready == 0) return ReturnEvent;
+
+    i = ReadySet_Highest(Ready);
+    me = &HostedServices[i];
+    ThisEvent = me->queue[me->head];
+    if (++me->head == me->size) me->head = 0;
+    if (--me->count == 0) ReadySet_Remove(Ready, i);
+    // queue the next turn before Run, a post from inside Run then finds it
+    // queued
+    if (Ready != 0) Wake();
+
+    ThisEvent = me->Run(ThisEvent);
+    if (ThisEvent.EventType == ES_ERROR) {
+        ReturnEvent = ThisEvent;
+    }
+    return ReturnEvent;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// queues SERVICES_READY unless one already is
+static uint8_t Wake(void) {
+    ES_Event Notice;
+
+    if (Waking) return TRUE;
+    Notice.EventType = SERVICES_READY;
+    Notice.EventParam = 0;
+    Waking = ES_PostToService(MyPriority, Notice);
+    return Waking;
+}
+
+#endif /* NUM_HOSTED_SERVICES > 0 */
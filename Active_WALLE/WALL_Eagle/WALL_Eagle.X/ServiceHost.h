@@ -0,0 +1,98 @@
+/*
+ * File:   ServiceHost.h
+ *
+ * Runs up to 32 services inside a single framework service. The framework
+ * scheduler stops at MAX_NUM_SERVICES (8), so services added past that are
+ * listed under "hosted_services" in ES_Spec.json instead of "services".
+ * ES_Gen.py then writes their table into ES_Hosted.c and their headers into
+ * ES_Hosted.h, and ServiceHost has to be one of the framework services.
+ * WheelCalService, which only runs on request, is hosted.
+ *
+ * A hosted service is written exactly like a framework one, with its index
+ * in the hosted list as its priority (higher index, higher priority):
+ *
+ *   uint8_t InitX(uint8_t Priority);    // MyPriority = Priority, post ES_INIT
+ *   uint8_t PostX(ES_Event ThisEvent) {
+ *       return ServiceHost_Post(MyPriority, ThisEvent);
+ *   }
+ *   ES_Event RunX(ES_Event ThisEvent);
+ *
+ * Each hosted service has its own FIFO. A post marks the service in a 32 bit
+ * ready set (ReadySet.h) and makes sure one SERVICES_READY is queued with the
+ * host. Every SERVICES_READY runs one event of the highest ready service,
+ * found with a single clz, and queues the next SERVICES_READY while anything
+ * is still ready, so the framework services and event checkers get their
+ * turn between hosted events just as they do between framework ones. A
+ * SERVICES_READY that does not fit in the host's queue is posted again by
+ * the next event the host runs, which the full queue guarantees.
+ *
+ * Anything else the host receives (ES_PostAll, keyboard input) is passed on
+ * to every hosted service.
+ */
+
+#ifndef SERVICEHOST_H
+#define	SERVICEHOST_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef struct {
+    uint8_t(*Init)(uint8_t Priority);
+    ES_Event(*Run)(ES_Event ThisEvent);
+    ES_Event *queue;
+    uint8_t size;
+    uint8_t head;
+    uint8_t count;
+} HostedService_t;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES                                                            *
+ ******************************************************************************/
+extern HostedService_t HostedServices[]; // generated into ES_Hosted.c, NUM_HOSTED_SERVICES long
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function InitServiceHost(uint8_t Priority)
+ * @param Priority - the host's framework priority
+ * @return TRUE if every hosted service initialised
+ * @brief Calls the hosted Init functions in order, lowest priority first. */
+uint8_t InitServiceHost(uint8_t Priority);
+
+/**
+ * @Function ServiceHost_Post(uint8_t Priority, ES_Event ThisEvent)
+ * @param Priority - the hosted service's index
+ * @return TRUE or FALSE if its queue is full
+ * @brief The hosted counterpart of ES_PostToService(). */
+uint8_t ServiceHost_Post(uint8_t Priority, ES_Event ThisEvent);
+
+/**
+ * @Function PostServiceHost(ES_Event ThisEvent)
+ * @return TRUE or FALSE
+ * @brief Posts to the host itself, which passes the event to every hosted
+ *        service. */
+uint8_t PostServiceHost(ES_Event ThisEvent);
+
+/**
+ * @Function RunServiceHost(ES_Event ThisEvent)
+ * @return ES_NO_EVENT, or the first ES_ERROR a hosted service returns
+ * @brief Dispatches one hosted event per SERVICES_READY. */
+ES_Event RunServiceHost(ES_Event ThisEvent);
+
+#ifdef	__cplusplus
+}
+#endif
+
+// the hosted services' Post functions, for the timers like the framework's
+#include "ES_Hosted.h"
+
+#endif	/* SERVICEHOST_H */
@@ -0,0 +1,99 @@
+/*
+ * File:   StateStats.c
+ *
+ * Per machine dwell time, visit and transition counters, see StateStats.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "StateStats.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define Saturate16(count) if ((count) < UINT16_MAX) (count)++
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static StateStats_t *tables = NULL;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void StateStats_Enter(StateStats_t *stats, uint8_t state) {
+    uint32_t now = ES_Timer_GetTime();
+    StateStats_t *table;
+
+    if (state >= stats->num_states) return;
+    if (stats->current == STATE_STATS_NONE) {
+        // first entry, link the table in unless it already is
+        for (table = tables; table != NULL && table != stats; table = table->next);
+        if (table == NULL) {
+            stats->next = tables;
+            tables = stats;
+        }
+    } else {
+        if (stats->timing) stats->dwell[stats->current] += now - stats->entered_at;
+        Saturate16(stats->transitions[stats->current * stats->num_states + state]);
+    }
+    Saturate16(stats->visits[state]);
+    stats->current = state;
+    stats->entered_at = now;
+    stats->timing = TRUE;
+}
+
+void StateStats_Leave(StateStats_t *stats) {
+    if (stats->current == STATE_STATS_NONE || !stats->timing) return;
+    stats->dwell[stats->current] += ES_Timer_GetTime() - stats->entered_at;
+    stats->timing = FALSE;
+}
+
+void StateStats_Dump(void) {
+    uint32_t now = ES_Timer_GetTime();
+    uint32_t dwell;
+    StateStats_t *table;
+    uint8_t from, to, n;
+
+    printf("\r\n#STATS begin %lu", (unsigned long) now);
+    for (table = tables; table != NULL; table = table->next) {
+        n = table->num_states;
+        for (from = 0; from < n; from++) {
+            dwell = table->dwell[from];
+            if (from == table->current && table->timing) dwell += now - table->entered_at;
+            if (table->visits[from] == 0 && dwell == 0) continue;
+            printf("\r\nS %s %s %u %lu", table->machine, table->state_names[from],
+                    table->visits[from], (unsigned long) dwell);
+        }
+        for (from = 0; from < n; from++) {
+            for (to = 0; to < n; to++) {
+                if (table->transitions[from * n + to] == 0) continue;
+                printf("\r\nT %s %s %s %u", table->machine, table->state_names[from],
+                        table->state_names[to], table->transitions[from * n + to]);
+            }
+        }
+    }
+    printf("\r\n#STATS end\r\n");
+}
+
+void StateStats_Clear(void) {
+    uint32_t now = ES_Timer_GetTime();
+    StateStats_t *table;
+    uint8_t n;
+
+    for (table = tables; table != NULL; table = table->next) {
+        n = table->num_states;
+        memset(table->dwell, 0, n * sizeof (uint32_t));
+        memset(table->visits, 0, n * sizeof (uint16_t));
+        memset(table->transitions, 0, n * n * sizeof (uint16_t));
+        table->entered_at = now;
+    }
+}
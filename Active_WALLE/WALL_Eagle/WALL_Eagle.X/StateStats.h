@@ -0,0 +1,109 @@
+/*
+ * File:   StateStats.h
+ *
+ * Residence time and transition telemetry for the state machines. Each
+ * machine declares its table with STATE_STATS() next to its StateNames[] and
+ * calls StateStats_Enter() wherever it changes CurrentState. Per state the
+ * table accumulates total dwell time and visit count, plus a from/to matrix of
+ * transition counts, all in fixed RAM sized from the machine's own state
+ * count.
+ *
+ * A sub machine keeps its CurrentState when its parent state exits, it only
+ * sees the ES_EXIT passed down. It calls StateStats_Leave() on every ES_EXIT
+ * it runs, so that state stops timing until the parent enters again.
+ *
+ * StateStats_Dump() prints every table over serial in a line format that
+ * StateStats.py collects and aggregates on the host:
+ *
+ *   #STATS begin <ms>
+ *   S <machine> <state> <visits> <dwell ms>
+ *   T <machine> <from state> <to state> <count>
+ *   #STATS end
+ *
+ * Counters saturate instead of wrapping.
+ */
+
+#ifndef STATESTATS_H
+#define	STATESTATS_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#define STATE_STATS_NONE 0xFF   // no state entered yet
+
+#define STATE_STATS_DUMP_KEY 's' // serial key that triggers a dump
+
+/* Declares the table for one machine. names must be the machine's StateNames
+ * array (not a pointer), it sizes every array in the table. */
+#define STATE_STATS(table, machine, names) \
+    static uint32_t table##_dwell[sizeof (names) / sizeof (names[0])]; \
+    static uint16_t table##_visits[sizeof (names) / sizeof (names[0])]; \
+    static uint16_t table##_transitions[(sizeof (names) / sizeof (names[0])) * \
+                                        (sizeof (names) / sizeof (names[0]))]; \
+    static StateStats_t table = {machine, names, sizeof (names) / sizeof (names[0]), \
+        STATE_STATS_NONE, 0, 0, table##_dwell, table##_visits, table##_transitions, 0}
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef struct StateStats_t StateStats_t;
+
+struct StateStats_t {
+    const char *machine;
+    const char * const *state_names;
+    uint8_t num_states;
+    uint8_t current;          // state being timed, STATE_STATS_NONE at reset
+    uint32_t entered_at;      // ES_Timer_GetTime() when current was entered
+    uint8_t timing;           // FALSE once current has been left
+    uint32_t *dwell;          // ms spent in each state
+    uint16_t *visits;         // entries into each state
+    uint16_t *transitions;    // [from * num_states + to]
+    StateStats_t *next;       // registered tables, linked on first entry
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function StateStats_Enter(StateStats_t *stats, uint8_t state)
+ * @param stats - the machine's table
+ * @param state - the state being entered
+ * @return None
+ * @brief Closes the dwell interval of the current state, counts the
+ *        transition and the visit and starts timing the new state. */
+void StateStats_Enter(StateStats_t *stats, uint8_t state);
+
+/**
+ * @Function StateStats_Leave(StateStats_t *stats)
+ * @param stats - the machine's table
+ * @return None
+ * @brief Closes the dwell interval of the current state. The next
+ *        StateStats_Enter() still counts the transition from it. */
+void StateStats_Leave(StateStats_t *stats);
+
+/**
+ * @Function StateStats_Dump(void)
+ * @return None
+ * @brief Prints every registered table, the state currently being timed is
+ *        included up to now. Blocks while printing. */
+void StateStats_Dump(void);
+
+/**
+ * @Function StateStats_Clear(void)
+ * @return None
+ * @brief Zeroes every registered table, current states keep being timed from
+ *        now. */
+void StateStats_Clear(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* STATESTATS_H */
@@ -0,0 +1,122 @@
+import sys
+import logging
+
+# StateStats.py
+#
+# Aggregates the state machine telemetry printed by StateStats_Dump() (press
+# 's' on the serial terminal). Each dump is cumulative since reset, so only
+# the last complete dump of every log counts; logs of several matches are
+# summed. Prints, per machine, the states ranked by total dwell time and the
+# most frequent transitions.
+#
+# usage: python StateStats.py log [log ...]
+#        python StateStats.py -p COM3      (requests a dump over serial, needs pyserial)
+
+DumpKey = b's'
+TopTransitions = 10
+
+
+class Dump(object):
+
+	def __init__(self):
+		self.states = {}       # (machine, state) -> [visits, dwell ms]
+		self.transitions = {}  # (machine, from, to) -> count
+
+	def add(self, other):
+		for key, (visits, dwell) in other.states.items():
+			entry = self.states.setdefault(key, [0, 0])
+			entry[0] += visits
+			entry[1] += dwell
+		for key, count in other.transitions.items():
+			self.transitions[key] = self.transitions.get(key, 0) + count
+
+
+# returns the last complete dump in lines, or None
+def parseDump(lines):
+	last = None
+	current = None
+	for line in lines:
+		fields = line.split()
+		if not fields:
+			continue
+		if fields[0] == '#STATS' and len(fields) > 1:
+			if fields[1] == 'begin':
+				current = Dump()
+			elif fields[1] == 'end' and current is not None:
+				last = current
+				current = None
+		elif current is None:
+			continue
+		elif fields[0] == 'S' and len(fields) == 5:
+			current.states[(fields[1], fields[2])] = [int(fields[3]), int(fields[4])]
+		elif fields[0] == 'T' and len(fields) == 5:
+			current.transitions[(fields[1], fields[2], fields[3])] = int(fields[4])
+	return last
+
+
+def readSerial(port):
+	import serial
+	with serial.Serial(port, 115200, timeout=2) as link:
+		link.reset_input_buffer()
+		link.write(DumpKey)
+		lines = []
+		while True:
+			line = link.readline().decode('ascii', 'replace')
+			if line == '':
+				break
+			lines.append(line)
+			if line.startswith('#STATS end'):
+				break
+	return lines
+
+
+def report(total, runs):
+	machines = sorted(set(machine for machine, state in total.states))
+	for machine in machines:
+		rows = [(state, v[0], v[1]) for (m, state), v in total.states.items() if m == machine]
+		machineTime = sum(row[2] for row in rows) or 1
+		rows.sort(key=lambda row: row[2], reverse=True)
+		print('\n%s (%d run%s)' % (machine, runs, '' if runs == 1 else 's'))
+		print('  %-28s %8s %10s %6s %10s' % ('state', 'visits', 'dwell ms', '%', 'ms/visit'))
+		for state, visits, dwell in rows:
+			print('  %-28s %8d %10d %6.1f %10.1f' % (state, visits, dwell, 100.0 * dwell / machineTime,
+					float(dwell) / visits if visits else 0.0))
+		edges = [(count, src, dst) for (m, src, dst), count in total.transitions.items() if m == machine]
+		edges.sort(reverse=True)
+		if edges:
+			print('  top transitions:')
+			for count, src, dst in edges[:TopTransitions]:
+				print('    %6d  %s -> %s' % (count, src, dst))
+
+
+def main(argv):
+	sources = []
+	if len(argv) == 2 and argv[0] == '-p':
+		sources.append((argv[1], readSerial(argv[1])))
+	else:
+		for fileName in argv:
+			with open(fileName, 'r') as f:
+				sources.append((fileName, f.readlines()))
+	if not sources:
+		logging.error('no logs given')
+		return 1
+
+	total = Dump()
+	runs = 0
+	for name, lines in sources:
+		dump = parseDump(lines)
+		if dump is None:
+			logging.warning('no complete dump in ' + name)
+			continue
+		total.add(dump)
+		runs += 1
+	if runs == 0:
+		return 1
+	report(total, runs)
+	return 0
+
+
+if __name__ == '__main__':
+	logging.basicConfig(level=logging.INFO, format='[%(levelname)s]%(asctime)s: %(message)s',
+			stream=sys.stdout)
+	sys.exit(main(sys.argv[1:]))
@@ -33,6 +33,8 @@
 #include "TopHSM.h"
 #include "TapeFollowSM.h"
 #include "motors.h"
+#include "WorldState.h"
+#include "StateStats.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -63,7 +65,7 @@ typedef enum {
     LeftTapeLost,
 } TapeFollowSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"MoveForward",
 	"ShiftDirection",
@@ -89,18 +91,10 @@ static const char *StateNames[] = {
 /* You will need MyPriority and the state variable; you may need others as well.
  * The type of state variable should match that of enum in header file. */
 
-static TapeFollowSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
+// the state lives in each TapeFollowSM_t, instances share the telemetry
+STATE_STATS(Stats, "TapeFollowSM", StateNames);
 static uint8_t MyPriority;
 
-//Status indicators
-uint8_t FR_tripped = FALSE;
-uint8_t MR_tripped = FALSE;
-uint8_t ML_tripped = FALSE;
-uint8_t FL_tripped = FALSE;
-
-//uint8_t last_tw = 0;
-uint8_t been_awhile = FALSE;
-
 
 
 /*******************************************************************************
@@ -117,13 +111,15 @@ uint8_t been_awhile = FALSE;
  *        to rename this to something appropriate.
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
-uint8_t InitTapeFollowSM(void) {
+uint8_t InitTapeFollowSM(TapeFollowSM_t *me) {
     ES_Event returnEvent;
 
-    ES_Timer_InitTimer(TAPE_FOLLOW_STARTUP_TIMER, 500);
+    ES_Timer_InitTimer(me->startup_timer, 500);
 
-    CurrentState = MoveForward;
-    returnEvent = RunTapeFollowSM(INIT_EVENT);
+    me->state = MoveForward;
+    me->been_awhile = FALSE;
+    StateStats_Enter(&Stats, me->state);
+    returnEvent = RunTapeFollowSM(me, INIT_EVENT);
     if (returnEvent.EventType == ES_NO_EVENT) {
         return TRUE;
     }
@@ -145,42 +141,22 @@ uint8_t InitTapeFollowSM(void) {
  *       not consumed as these need to pass pack to the higher level state machine.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
-ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
+ES_Event RunTapeFollowSM(TapeFollowSM_t *me, ES_Event ThisEvent) {
     uint8_t makeTransition = FALSE; // use to flag transition
     TapeFollowSMState_t nextState; // <- change type to correct enum
 
     ES_Tattle(); // trace call stack
 
-    // Assemble True/False declarations for each tape sensor
-    if (ThisEvent.EventType == TAPE_SENSOR_TRIPPED) {
-        if (ThisEvent.EventParam & FR_MASK) {
-            FR_tripped = TRUE;
-        } else {
-            FR_tripped = FALSE;
-        }
-        if (ThisEvent.EventParam & MR_MASK) {
-            MR_tripped = TRUE;
-        } else {
-            MR_tripped = FALSE;
-        }
-        if (ThisEvent.EventParam & ML_MASK) {
-            ML_tripped = TRUE;
-        } else {
-            ML_tripped = FALSE;
-        }
-        if (ThisEvent.EventParam & FL_MASK) {
-            FL_tripped = TRUE;
-        } else {
-            FL_tripped = FALSE;
-        }
+    if (ThisEvent.EventType == ES_EXIT) {
+        StateStats_Leave(&Stats); // our own transition, or the parent's
     }
-    
 
 
 
-    switch (CurrentState) {
+
+    switch (me->state) {
         case InitPSubState: // If current state is initial Psedudo State
-            if (ThisEvent.EventType == ES_TIMEOUT && ThisEvent.EventParam == TAPE_FOLLOW_STARTUP_TIMER)// only respond to ES_Init
+            if (ThisEvent.EventType == ES_TIMEOUT && ThisEvent.EventParam == me->startup_timer)// only respond to ES_Init
             {
                 // this is where you would put any actions associated with the
                 // transition from the initial pseudo-state into the actual
@@ -197,19 +173,19 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     BotMoveForward(FAST_SPEED);
-                    ES_Timer_InitTimer(TAPE_FOLLOW_TIMER, LOST_TIMEOUT);
+                    ES_Timer_InitTimer(me->timer, LOST_TIMEOUT);
                     break;
                 case TAPE_SENSOR_TRIPPED:
                     ThisEvent.EventType = ES_NO_EVENT;
-                    if ((FR_tripped | MR_tripped) && !ML_tripped && !FL_tripped) {
+                    if ((WorldState_TapeOn(FR_MASK) | WorldState_TapeOn(MR_MASK)) && !WorldState_TapeOn(ML_MASK) && !WorldState_TapeOn(FL_MASK)) {
                         nextState = FoundRightTape;
                         makeTransition = TRUE;
                         //ThisEvent.EventType = ES_NO_EVENT;
-                    } else if ((FL_tripped | ML_tripped) && !MR_tripped && !FR_tripped) {
+                    } else if ((WorldState_TapeOn(FL_MASK) | WorldState_TapeOn(ML_MASK)) && !WorldState_TapeOn(MR_MASK) && !WorldState_TapeOn(FR_MASK)) {
                         nextState = FoundLeftTape;
                         makeTransition = TRUE;
                         //ThisEvent.EventType = ES_NO_EVENT;
-                    } else if (!FL_tripped && !ML_tripped && !MR_tripped && !FR_tripped) {
+                    } else if (!WorldState_TapeOn(FL_MASK) && !WorldState_TapeOn(ML_MASK) && !WorldState_TapeOn(MR_MASK) && !WorldState_TapeOn(FR_MASK)) {
                         ; // do nothing
                     } else {
                         //BotRPivotLeft(SLOW_SPEED);
@@ -217,7 +193,7 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
                     }
                     break;
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == TAPE_FOLLOW_TIMER){
+                    if (ThisEvent.EventParam == me->timer){
                         nextState = ShiftDirection;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -231,10 +207,10 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
             BotTankTurnLeft(300);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    ES_Timer_InitTimer(TAPE_FOLLOW_TIMER, TURN_TIME);
+                    ES_Timer_InitTimer(me->timer, TURN_TIME);
                     break;
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == TAPE_FOLLOW_TIMER) {
+                    if (ThisEvent.EventParam == me->timer) {
                         nextState = MoveForward;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -249,30 +225,30 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     BotMoveForward(SLOW_SPEED);
-                    ES_Timer_InitTimer(TAPE_FOLLOW_TIMER, STRAIGHT_TIME);
-                    been_awhile = FALSE;
+                    ES_Timer_InitTimer(me->timer, STRAIGHT_TIME);
+                    me->been_awhile = FALSE;
                     break;
                 case TAPE_SENSOR_TRIPPED:
                     ThisEvent.EventType = ES_NO_EVENT;
-                    if (MR_tripped || !FR_tripped) {
+                    if (WorldState_TapeOn(MR_MASK) || !WorldState_TapeOn(FR_MASK)) {
                         nextState = RightRealign;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
-                    if (!FR_tripped) {
+                    if (!WorldState_TapeOn(FR_MASK)) {
                         nextState = RightTapeLost;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
-                    if (FL_tripped) {
+                    if (WorldState_TapeOn(FL_MASK)) {
                         nextState = MoveForward;
                         makeTransition = TRUE;
                         ThisEvent.EventType = BUMPER_TRIPPED;
                         ThisEvent.EventParam = 0x01;
                     }
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == TAPE_FOLLOW_TIMER) {
-                        been_awhile = TRUE;
+                    if (ThisEvent.EventParam == me->timer) {
+                        me->been_awhile = TRUE;
                     }
                     break;
                 default: // all unhandled events pass the event back up to the next level
@@ -282,24 +258,24 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
         case RightRealign:
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    if (been_awhile) BotRRPivotLeft(SLOW_SPEED);
+                    if (me->been_awhile) BotRRPivotLeft(SLOW_SPEED);
                     else BotRPivotLeft(SLOW_SPEED);
                     break;
                 case TAPE_SENSOR_TRIPPED:
                     ThisEvent.EventType = ES_NO_EVENT;
-                    if (!MR_tripped && FR_tripped) {
+                    if (!WorldState_TapeOn(MR_MASK) && WorldState_TapeOn(FR_MASK)) {
                         nextState = FoundRightTape;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
-                    if (!MR_tripped && !FR_tripped) {
+                    if (!WorldState_TapeOn(MR_MASK) && !WorldState_TapeOn(FR_MASK)) {
                         nextState = MoveForward;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == TAPE_FOLLOW_TIMER) {
-                        been_awhile = TRUE;
+                    if (ThisEvent.EventParam == me->timer) {
+                        me->been_awhile = TRUE;
                     }
                     break;
                 default: // all unhandled events pass the event back up to the next level
@@ -310,17 +286,17 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     BotRRPivotRight(SLOW_SPEED);
-                    ES_Timer_InitTimer(TAPE_FOLLOW_TIMER, ESCAPE_TIMEOUT);
+                    ES_Timer_InitTimer(me->timer, ESCAPE_TIMEOUT);
                     break;
                 case TAPE_SENSOR_TRIPPED:
                     ThisEvent.EventType = ES_NO_EVENT;
-                    if (FR_tripped) {
+                    if (WorldState_TapeOn(FR_MASK)) {
                         nextState = FoundRightTape;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == TAPE_FOLLOW_TIMER){
+                    if (ThisEvent.EventParam == me->timer){
                         nextState = MoveForward;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -334,30 +310,30 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     BotMoveForward(SLOW_SPEED);
-                    ES_Timer_InitTimer(TAPE_FOLLOW_TIMER, STRAIGHT_TIME);
-                    been_awhile = FALSE;
+                    ES_Timer_InitTimer(me->timer, STRAIGHT_TIME);
+                    me->been_awhile = FALSE;
                     break;
                 case TAPE_SENSOR_TRIPPED:
                     ThisEvent.EventType = ES_NO_EVENT;
-                    if (ML_tripped || !FL_tripped) {
+                    if (WorldState_TapeOn(ML_MASK) || !WorldState_TapeOn(FL_MASK)) {
                         nextState = LeftRealign;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
-                    if (!FL_tripped) {
+                    if (!WorldState_TapeOn(FL_MASK)) {
                         nextState = LeftTapeLost;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
-                    if (FR_tripped) {
+                    if (WorldState_TapeOn(FR_MASK)) {
                         nextState = MoveForward;
                         makeTransition = TRUE;
                         ThisEvent.EventType = BUMPER_TRIPPED;
                         ThisEvent.EventParam = 0x10;
                     }
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == TAPE_FOLLOW_TIMER) {
-                        been_awhile = TRUE;
+                    if (ThisEvent.EventParam == me->timer) {
+                        me->been_awhile = TRUE;
                     }
                     break;
                 default: // all unhandled events pass the event back up to the next level
@@ -367,17 +343,17 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
         case LeftRealign:
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    if (been_awhile) BotRRPivotRight(SLOW_SPEED);
+                    if (me->been_awhile) BotRRPivotRight(SLOW_SPEED);
                     else BotRPivotRight(SLOW_SPEED);
                     break;
                 case TAPE_SENSOR_TRIPPED:
                     ThisEvent.EventType = ES_NO_EVENT;
-                    if (!ML_tripped && FL_tripped) {
+                    if (!WorldState_TapeOn(ML_MASK) && WorldState_TapeOn(FL_MASK)) {
                         nextState = FoundLeftTape;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
-                    if (!ML_tripped && !FL_tripped) {
+                    if (!WorldState_TapeOn(ML_MASK) && !WorldState_TapeOn(FL_MASK)) {
                         nextState = MoveForward;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -390,17 +366,17 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
                     BotRRPivotLeft(SLOW_SPEED);
-                    ES_Timer_InitTimer(TAPE_FOLLOW_TIMER, ESCAPE_TIMEOUT);
+                    ES_Timer_InitTimer(me->timer, ESCAPE_TIMEOUT);
                     break;
                 case TAPE_SENSOR_TRIPPED:
                     ThisEvent.EventType = ES_NO_EVENT;
-                    if (FL_tripped) {
+                    if (WorldState_TapeOn(FL_MASK)) {
                         nextState = FoundLeftTape;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
                     }
                 case ES_TIMEOUT:
-                    if (ThisEvent.EventParam == TAPE_FOLLOW_TIMER){
+                    if (ThisEvent.EventParam == me->timer){
                         nextState = MoveForward;
                         makeTransition = TRUE;
                         ThisEvent.EventType = ES_NO_EVENT;
@@ -416,9 +392,10 @@ ES_Event RunTapeFollowSM(ES_Event ThisEvent) {
 
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
-        RunTapeFollowSM(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunTapeFollowSM(ENTRY_EVENT); // <- rename to your own Run function
+        RunTapeFollowSM(me, EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
+        me->state = nextState;
+        RunTapeFollowSM(me, ENTRY_EVENT); // <- rename to your own Run function
     }
 
     ES_Tail(); // trace call stack end
@@ -30,20 +30,29 @@
 /*******************************************************************************
  * PUBLIC #DEFINES                                                             *
  ******************************************************************************/
-
+// initializer for a TapeFollowSM_t, Init still has to run before the first Run
+#define TAPE_FOLLOW_SM(timer, startup_timer) {0, 0, timer, startup_timer}
 
 /*******************************************************************************
  * PUBLIC TYPEDEFS                                                             *
  ******************************************************************************/
-
+/* One tape follower. The parent state machine owns it and hands it to every
+ * call, so each parent keeps its own progress. Instances that run at the same
+ * time need their own timers. */
+typedef struct {
+    uint8_t state;          // current state, only TapeFollowSM.c knows the values
+    uint8_t been_awhile;    // STRAIGHT_TIME ran out while on the tape edge
+    uint8_t timer;          // state timeouts
+    uint8_t startup_timer;  // delay before the first move
+} TapeFollowSM_t;
 
 /*******************************************************************************
  * PUBLIC FUNCTION PROTOTYPES                                                  *
  ******************************************************************************/
 
 /**
- * @Function InitTemplateSubHSM(void)
- * @param Priority - internal variable to track which event queue to use
+ * @Function InitTapeFollowSM(TapeFollowSM_t *me)
+ * @param me - the instance to (re)start
  * @return TRUE or FALSE
  * @brief This will get called by the framework at the beginning of the code
  *        execution. It will post an ES_INIT event to the appropriate event
@@ -51,10 +60,11 @@
  *        to rename this to something appropriate.
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
-uint8_t InitTapeFollowSM(void);
+uint8_t InitTapeFollowSM(TapeFollowSM_t *me);
 
 /**
- * @Function RunTemplateSubHSM(ES_Event ThisEvent)
+ * @Function RunTapeFollowSM(TapeFollowSM_t *me, ES_Event ThisEvent)
+ * @param me - the instance to run
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
  * @brief This function is where you implement the whole of the heirarchical state
@@ -68,7 +78,7 @@ uint8_t InitTapeFollowSM(void);
  *       not consumed as these need to pass pack to the higher level state machine.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
-ES_Event RunTapeFollowSM(ES_Event ThisEvent);
+ES_Event RunTapeFollowSM(TapeFollowSM_t *me, ES_Event ThisEvent);
 
 #endif /* TAPEFOLLOWSM_H */
 
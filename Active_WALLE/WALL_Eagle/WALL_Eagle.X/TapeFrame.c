@@ -0,0 +1,97 @@
+/*
+ * File:   TapeFrame.c
+ *
+ * Per channel classification, hysteresis and drift tracking for the tape
+ * sensor array. See TapeFrame.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <string.h>
+#include "TapeFrame.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+// drift tracking: EMA weight is 1/64
+#define DRIFT_SHIFT 6
+#define MIN_DRIFT_SEPARATION (100 << TAPE_MEAN_SHIFT)
+#define HYSTERESIS_DIVISOR 4    // half band = cluster separation / 4
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static void SetThresholds(TapeFrame_t *frame, uint8_t channel);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void TapeFrame_Init(TapeFrame_t *frame, const uint16_t *masks, int32_t black_mean, int32_t white_mean) {
+    uint8_t i;
+    memset(frame, 0, sizeof (TapeFrame_t));
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        frame->mask[i] = masks[i];
+        frame->state[i] = WHITE;
+        TapeFrame_SetClusters(frame, i, black_mean, white_mean);
+    }
+}
+
+void TapeFrame_SetClusters(TapeFrame_t *frame, uint8_t channel, int32_t black_mean, int32_t white_mean) {
+    frame->black_mean[channel] = black_mean;
+    frame->white_mean[channel] = white_mean;
+    SetThresholds(frame, channel);
+}
+
+uint16_t TapeFrame_Process(TapeFrame_t *frame) {
+    uint8_t i;
+    uint16_t status = 0;
+    int32_t reading, black, white;
+
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        frame->diff[i] = frame->off[i] - frame->on[i];
+    }
+
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        if (frame->diff[i] > frame->white_threshold[i]) {
+            frame->state[i] = WHITE;
+        } else if (frame->diff[i] < frame->black_threshold[i]) {
+            frame->state[i] = BLACK;
+        } else {
+            continue; // inside the band, keep the last state and leave the means alone
+        }
+        // exponential estimate of the cluster this channel is confidently in
+        reading = (frame->diff[i] > TAPE_ADC_MAX ? TAPE_ADC_MAX : frame->diff[i]) << TAPE_MEAN_SHIFT;
+        black = frame->black_mean[i];
+        white = frame->white_mean[i];
+        if (frame->state[i] == BLACK) {
+            black += (reading - black) >> DRIFT_SHIFT;
+        } else {
+            white += (reading - white) >> DRIFT_SHIFT;
+        }
+        // never let the two clusters collapse into each other
+        if (white - black >= MIN_DRIFT_SEPARATION) {
+            TapeFrame_SetClusters(frame, i, black, white);
+        }
+    }
+
+    for (i = 0; i < TAPE_FRAME_CHANNELS; i++) {
+        if (frame->state[i] == BLACK) status |= frame->mask[i];
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+// Hysteresis band centred between the two clusters, width scaled to their
+// separation so a low contrast channel gets a narrow band
+static void SetThresholds(TapeFrame_t *frame, uint8_t channel) {
+    int32_t mid = (frame->black_mean[channel] + frame->white_mean[channel]) >> (TAPE_MEAN_SHIFT + 1);
+    int32_t half_band = ((frame->white_mean[channel] - frame->black_mean[channel]) >> TAPE_MEAN_SHIFT) / HYSTERESIS_DIVISOR;
+    frame->black_threshold[channel] = mid - half_band;
+    frame->white_threshold[channel] = mid + half_band;
+}
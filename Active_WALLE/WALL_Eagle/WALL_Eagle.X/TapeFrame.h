@@ -0,0 +1,85 @@
+/*
+ * File:   TapeFrame.h
+ *
+ * One frame of the tape sensor array, laid out as a struct of arrays: every
+ * field is an N channel array indexed by sensor, so each processing step is a
+ * single tight loop over contiguous data and the cost per frame only grows
+ * with the channel count, not with more copies of the same code.
+ *
+ * Nothing in here touches the framework or the hardware. TapeSensorService
+ * fills on[] and off[] from the ADC and calls TapeFrame_Process(); the same
+ * code builds on the host for benchmarking.
+ */
+
+#ifndef TAPEFRAME_H
+#define	TAPEFRAME_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+#ifndef TAPE_FRAME_CHANNELS
+#include "PinsMaster.h"
+#define TAPE_FRAME_CHANNELS NUM_TAPE_SENSORS
+#endif
+
+#define TAPE_ADC_MAX 1023
+#define TAPE_MEAN_SHIFT 4   // cluster means are x16 fixed point
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef enum {
+    BLACK,
+    WHITE
+} tape_status;
+
+typedef struct {
+    uint16_t mask[TAPE_FRAME_CHANNELS];            // status bit set on black
+    uint16_t on[TAPE_FRAME_CHANNELS];              // reading with the flash on
+    uint16_t off[TAPE_FRAME_CHANNELS];             // reading with the flash off
+    uint16_t diff[TAPE_FRAME_CHANNELS];            // off - on
+    uint8_t state[TAPE_FRAME_CHANNELS];            // tape_status
+    uint16_t black_threshold[TAPE_FRAME_CHANNELS];
+    uint16_t white_threshold[TAPE_FRAME_CHANNELS];
+    int32_t black_mean[TAPE_FRAME_CHANNELS];       // cluster centres, x16
+    int32_t white_mean[TAPE_FRAME_CHANNELS];
+} TapeFrame_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function TapeFrame_Init(TapeFrame_t *frame, const uint16_t *masks, int32_t black_mean, int32_t white_mean)
+ * @param masks - TAPE_FRAME_CHANNELS status bits
+ * @param black_mean, white_mean - starting cluster centres (x16) for every channel
+ * @return None
+ * @brief Clears the frame, all channels start out WHITE. */
+void TapeFrame_Init(TapeFrame_t *frame, const uint16_t *masks, int32_t black_mean, int32_t white_mean);
+
+/**
+ * @Function TapeFrame_SetClusters(TapeFrame_t *frame, uint8_t channel, int32_t black_mean, int32_t white_mean)
+ * @return None
+ * @brief Sets one channel's cluster centres (x16) and recomputes its
+ *        hysteresis band from them. */
+void TapeFrame_SetClusters(TapeFrame_t *frame, uint8_t channel, int32_t black_mean, int32_t white_mean);
+
+/**
+ * @Function TapeFrame_Process(TapeFrame_t *frame)
+ * @return packed status, the OR of mask[] for every channel on black
+ * @brief Computes diff[] from on[]/off[], classifies each channel against its
+ *        band (inside the band a channel keeps its state) and lets confident
+ *        readings pull their cluster centre along. */
+uint16_t TapeFrame_Process(TapeFrame_t *frame);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TAPEFRAME_H */
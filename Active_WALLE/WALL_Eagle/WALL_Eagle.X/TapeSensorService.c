@@ -13,12 +13,34 @@
 #include "IO_Ports.h"
 #include <stdio.h>
 #include "PinsMaster.h"
+#include "EventPool.h"
+#include "WorldState.h"
+#include "FlashStore.h"
+#include "TapeFrame.h"
+#include "ADFrame.h"
+#include "SensorRate.h"
+#include "EventMailbox.h"
+#include "SensorTier.h"
+#include "motors.h"
+#include "BootProfile.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 #define ARCHIVE_SIZE 10
 
+// calibration histogram, 32 bins of 32 counts each
+#define CAL_BINS 32
+#define CAL_BIN_SHIFT 5
+#define MIN_CAL_SEPARATION 150  // clusters closer than this are not trusted
+#define CAL_MAGIC 0x54415031    // "TAP1", bump when the record layout changes
+
+// frames to let go by after switching the LEDs, the one being converted at
+// the switch may have sampled part of the pins before it
+#define FLASH_SETTLE_FRAMES 2
+#define STARTUP_HOLD_TIME 500
+#define TRIPPED_HOLD_TIME 20
+
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
  ******************************************************************************/
@@ -27,6 +49,10 @@
 void ArchiveValue(uint16_t value);
 uint16_t FindArchiveMean(void);
 uint16_t FindMovingMean(void);
+void PostTapeReadings(uint16_t status);
+static void AccumulateCalibration(void);
+static void FinishCalibration(void);
+static uint8_t FindClusters(const uint16_t *hist, int32_t *black, int32_t *white);
 
 
 /*******************************************************************************
@@ -50,7 +76,22 @@ int archive_index = 0;
 
 char output[32];
 
-tape_sensor FL, ML, MR, FR;
+// channel order (FL, ML, MR, FR) matches the tape_diff[] payload
+static const unsigned int tape_pins[NUM_TAPE_SENSORS] = TAPE_SENSOR_PIN_LIST;
+static const uint16_t tape_masks[NUM_TAPE_SENSORS] = TAPE_SENSOR_MASK_LIST;
+static TapeFrame_t frame;
+
+// owned by TapeSensor_Demodulate(), the TIER_TAPE actor
+static ADFrame_Reader_t reader;
+static uint32_t flash_seq;      // newest AD frame when the LEDs last switched
+static uint32_t pair_time;      // ES time the dark frame of the latest change was captured
+static volatile uint8_t holding = TRUE; // ignore frames until TAPE_SENSOR_TIMER expires
+
+FLASH_STORE_PAGE(tape_cal_page);
+
+static volatile uint8_t calibrating = FALSE;
+static uint32_t cal_start;
+static uint16_t cal_hist[NUM_TAPE_SENSORS][CAL_BINS];
 
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
@@ -66,12 +107,29 @@ uint8_t InitTapeSensorService(uint8_t Priority) {
     IO_PortsSetPortOutputs(FLASH_PIN);
     InitMotors();
 
+    // Per sensor cluster centres come from flash if a sweep has been stored,
+    // otherwise they are placed so the thresholds match the old fixed ones
+    int32_t stored[NUM_TAPE_SENSORS][2];
+    uint8_t have_cal = FlashStore_Load(tape_cal_page, CAL_MAGIC, stored, sizeof (stored) / 4);
+    int i;
+    TapeFrame_Init(&frame, tape_masks,
+            ((3 * BLACK_TAPE_THRESHOLD - WHITE_TAPE_THRESHOLD) / 2) << TAPE_MEAN_SHIFT,
+            ((3 * WHITE_TAPE_THRESHOLD - BLACK_TAPE_THRESHOLD) / 2) << TAPE_MEAN_SHIFT);
+    for (i = 0; have_cal && i < NUM_TAPE_SENSORS; i++) {
+        TapeFrame_SetClusters(&frame, i, stored[i][0], stored[i][1]);
+    }
+    printf("\r\nTape thresholds from %s", have_cal ? "flash" : "defaults");
+
     // Initialize state machine
     currentState = SAMPLE_FLASH_ON;
-    FL.status = WHITE;
+    FLASH_ON;
+    flash_seq = ADFrame_Sequence();
+#ifdef TAPE_CALIBRATION
+    TapeSensor_StartCalibration();
+#endif
 
-    // Start the timer and let it run expiring every 2 ms
-    ES_Timer_InitTimer(TAPE_SENSOR_TIMER, 500);
+    // the tape actor samples every captured frame once the startup hold is over
+    ES_Timer_InitTimer(TAPE_SENSOR_TIMER, STARTUP_HOLD_TIME);
 
     ThisEvent.EventType = ES_INIT;
     if (ES_PostToService(MyPriority, ThisEvent) == TRUE) {
@@ -92,10 +150,6 @@ ES_Event RunTapeSensorService(ES_Event ThisEvent) {
     /********************************************
      in here you write your service code
      *******************************************/
-    static ES_EventTyp_t lastEvent = WHITE_TAPE_DETECTED;
-    ES_EventTyp_t curEvent;
-    sampleState nextState;
-    uint8_t makeTransition = FALSE;
     switch (ThisEvent.EventType) {
         case ES_TIMERACTIVE:
         case ES_INIT:
@@ -103,58 +157,26 @@ ES_Event RunTapeSensorService(ES_Event ThisEvent) {
             // go in the init function above.
             //
             // This section is used to reset service for some reason
+            BootProfile_Mark(BOOT_TAPE_SERVICE);
             break;
 
         case ES_TIMEOUT:
-            //printf("*");
-            ES_Timer_InitTimer(TAPE_SENSOR_TIMER, 2);
-            // Small state machine transitions between states every 2 ms at the timeout
-            switch (currentState) {
-                case SAMPLE_FLASH_ON: // Turn LEDs on
-                    //printf("1");
-                    FLASH_ON;
-                    if (AD_IsNewDataReady()) {
-                        nextState = SAMPLE_TAKE_SAMPLE_1;
-                        makeTransition = TRUE;
-                    }
-                    break;
-                case SAMPLE_TAKE_SAMPLE_1: // Take first sample
-                    //printf("2");
-                    TakeFirstSample();
-                    nextState = SAMPLE_FLASH_OFF;
-                    makeTransition = TRUE;
-                    break;
-                case SAMPLE_FLASH_OFF: // Turn LEDs off
-                    //printf("3");
-                    FLASH_OFF;
-                    if (AD_IsNewDataReady()) {
-                        nextState = SAMPLE_TAKE_SAMPLE_2;
-                        makeTransition = TRUE;
-                    }
-                    break;
-                case SAMPLE_TAKE_SAMPLE_2: // Take second sample and perform calculations
-                    //printf("4");
-                    TakeSecondSample();
-                    AssembleReadings();
-                    FindMovingMean();
-                    //printf("\n[Tape Status:\t%04x]\n[Tape Values:\t%d\t%d\t%d\t%d]\n\n", new_tape_data, FL.diff, ML.diff, MR.diff, FR.diff);
-                    //printf("[New: %d Old: %d]\n", new_tape_data, tape_data);
-                    if (new_tape_data != tape_data) {
-                        
-                        tape_data = new_tape_data;
-                        ReturnEvent.EventType = TAPE_SENSOR_TRIPPED;
-                        ReturnEvent.EventParam = tape_data;
-                        PostTopHSM(ReturnEvent);
-                        ES_Timer_InitTimer(TAPE_SENSOR_TIMER, 20);
-                    }
-                    nextState = SAMPLE_FLASH_ON;
-                    makeTransition = TRUE;
-                    break;
-            }
-            if (makeTransition) {
-                currentState = nextState;
-                makeTransition = FALSE;
-            }
+            holding = FALSE;
+            break;
+
+        case TAPE_PAIR_READY: // handed over by the actor, which holds until the timer
+            BootProfile_Mark(BOOT_TAPE_WARM);
+            tape_data = ThisEvent.EventParam;
+            FindMovingMean(); // new_tape_data is tape_data while the actor holds
+            WorldState_UpdateTape(tape_data);
+            ReturnEvent.EventType = TAPE_SENSOR_TRIPPED;
+            ReturnEvent.EventParam = tape_data;
+            PostTapeReadings(tape_data);
+            ES_Timer_InitTimer(TAPE_SENSOR_TIMER, TRIPPED_HOLD_TIME);
+            break;
+
+        case TAPE_CALIBRATION_DONE:
+            FinishCalibration();
             break;
             //#ifdef SIMPLESERVICE_TEST     // keep this as is for test harness      
             //    default:
@@ -167,6 +189,51 @@ ES_Event RunTapeSensorService(ES_Event ThisEvent) {
     return ReturnEvent;
 }
 
+void TapeSensor_Demodulate(void) {
+    const ADFrame_t *sample;
+    ES_Event ThisEvent;
+
+    if (holding) return;
+    sample = ADFrame_Next(&reader);
+    if (sample == NULL || sample->seq - flash_seq < FLASH_SETTLE_FRAMES) return;
+    // Small state machine alternates lit and dark frames
+    switch (currentState) {
+        case SAMPLE_FLASH_ON: // lit frame in, turn LEDs off
+            // a lit/dark pair is never split, the rate applies per pair
+            if (!SensorRate_Due(SENSOR_TAPE)) return;
+            TakeFirstSample(sample);
+            FLASH_OFF;
+            currentState = SAMPLE_FLASH_OFF;
+            break;
+        case SAMPLE_FLASH_OFF: // dark frame in, turn LEDs on and perform calculations
+            TakeSecondSample(sample);
+            FLASH_ON;
+            currentState = SAMPLE_FLASH_ON;
+            if (calibrating) {
+                AccumulateCalibration();
+                if (sample->timestamp - cal_start >= CALIBRATION_TIME) {
+                    // the histograms are the service's from here on
+                    calibrating = FALSE;
+                    ThisEvent.EventType = TAPE_CALIBRATION_DONE;
+                    ThisEvent.EventParam = 0;
+                    SensorTier_Post(PostTapeSensorService, ThisEvent);
+                }
+                break;
+            }
+            AssembleReadings();
+            if (new_tape_data != tape_data) {
+                // frame.diff stays as it is until the service lets go of holding
+                pair_time = sample->timestamp;
+                holding = TRUE;
+                ThisEvent.EventType = TAPE_PAIR_READY;
+                ThisEvent.EventParam = new_tape_data;
+                if (!SensorTier_Post(PostTapeSensorService, ThisEvent)) holding = FALSE;
+            }
+            break;
+    }
+    flash_seq = sample->seq;
+}
+
 /*******************************************************************************
  * PRIVATE FUNCTIONs                                                           *
  ******************************************************************************/
@@ -176,79 +243,35 @@ uint8_t dummy_func(void) {
     // Do Nothing
 }
 
-void TakeFirstSample(void) {
-    FL.sample1 = AD_ReadADPin(FAR_LEFT_TAPE_SENSOR_PIN);
-    ML.sample1 = AD_ReadADPin(MID_LEFT_TAPE_SENSOR_PIN);
-    MR.sample1 = AD_ReadADPin(MID_RIGHT_TAPE_SENSOR_PIN);
-    FR.sample1 = AD_ReadADPin(FAR_RIGHT_TAPE_SENSOR_PIN);
-}
-
-void TakeSecondSample(void) {
-    FL.sample2 = AD_ReadADPin(FAR_LEFT_TAPE_SENSOR_PIN);
-    ML.sample2 = AD_ReadADPin(MID_LEFT_TAPE_SENSOR_PIN);
-    MR.sample2 = AD_ReadADPin(MID_RIGHT_TAPE_SENSOR_PIN);
-    FR.sample2 = AD_ReadADPin(FAR_RIGHT_TAPE_SENSOR_PIN);
+void TakeFirstSample(const ADFrame_t *sample) {
+    int i;
+    for (i = 0; i < NUM_TAPE_SENSORS; i++) {
+        frame.on[i] = ADFrame_Read(sample, tape_pins[i]);
+    }
 }
 
-void UpdateStatus() {
-    FL.diff = FL.sample2 - FL.sample1;
-    //printf("|%d|\n", FL.diff);
-    if (FL.diff > WHITE_TAPE_THRESHOLD) {
-        FL.new_status = WHITE;
-    }
-    if (FL.diff < BLACK_TAPE_THRESHOLD) {
-        FL.new_status = BLACK;
-    }
-    if (FL.new_status != FL.status) {
-        FL.status = FL.new_status;
-        //printf("%d", FL.status);
-    }
-    // ML
-    ML.diff = ML.sample2 - ML.sample1;
-    if (ML.diff > WHITE_TAPE_THRESHOLD) {
-        ML.new_status = WHITE;
-    }
-    if (ML.diff < BLACK_TAPE_THRESHOLD) {
-        ML.new_status = BLACK;
-    }
-    if (ML.new_status != ML.status) {
-        ML.status = ML.new_status;
-        //printf("%d", ML.status);
-    }
-    // MR
-    MR.diff = MR.sample2 - MR.sample1;
-    if (MR.diff > WHITE_TAPE_THRESHOLD) {
-        MR.new_status = WHITE;
-    }
-    if (MR.diff < BLACK_TAPE_THRESHOLD) {
-        MR.new_status = BLACK;
-    }
-    if (MR.new_status != MR.status) {
-        MR.status = MR.new_status;
-        //printf("%d", MR.status);
-    }
-    // FR
-    FR.diff = FR.sample2 - FR.sample1;
-    //printf("%d\n", FR.diff);
-    if (FR.diff > WHITE_TAPE_THRESHOLD) {
-        FR.new_status = WHITE;
-    }
-    if (FR.diff < BLACK_TAPE_THRESHOLD) {
-        FR.new_status = BLACK;
-    }
-    if (FR.new_status != FR.status) {
-        FR.status = FR.new_status;
-        //printf("%d", FR.status);
+void TakeSecondSample(const ADFrame_t *sample) {
+    int i;
+    for (i = 0; i < NUM_TAPE_SENSORS; i++) {
+        frame.off[i] = ADFrame_Read(sample, tape_pins[i]);
     }
 }
 
 void AssembleReadings(void) {
-    UpdateStatus();
-    new_tape_data = 0;
-    if (FL.status == BLACK) new_tape_data |= (1 << 12);
-    if (ML.status == BLACK) new_tape_data |= (1 << 8);
-    if (MR.status == BLACK) new_tape_data |= (1 << 4);
-    if (FR.status == BLACK) new_tape_data |= 1;
+    new_tape_data = TapeFrame_Process(&frame);
+}
+
+void TapeSensor_StartCalibration(void) {
+    SensorTier_Lock();
+    memset(cal_hist, 0, sizeof (cal_hist));
+    cal_start = ES_Timer_GetTime();
+    calibrating = TRUE;
+    SensorTier_Unlock();
+    printf("\r\nTape calibration: sweep over tape and floor for %d ms", CALIBRATION_TIME);
+}
+
+uint8_t TapeSensor_IsCalibrating(void) {
+    return calibrating;
 }
 
 void ArchiveValue(uint16_t value) {
@@ -257,7 +280,7 @@ void ArchiveValue(uint16_t value) {
 }
 
 uint16_t FindArchiveMean(void) {
-    int points[8] = {0};
+    int points[ARCHIVE_SIZE] = {0};
     int i, j;
     for (i = 0; i < ARCHIVE_SIZE; i++) {
         for (j = 0; j <= i; j++) {
@@ -281,3 +304,97 @@ uint16_t FindMovingMean(void){
     return FindArchiveMean();
 }
 
+// Posts TAPE_SENSOR_TRIPPED with the full frame in a pool payload, falls back
+// to the packed status alone if the pool is empty. Goes through a mailbox
+// slot, so a reading TopHSM has not got to yet is replaced, not queued behind.
+// The actor is holding, so frame.diff and pair_time are still the change's.
+void PostTapeReadings(uint16_t status) {
+    ES_Event ThisEvent;
+    uint16_t handle = EventPool_Alloc();
+    SensorPayload_t *payload = EventPool_Get(handle);
+
+    ThisEvent.EventType = TAPE_SENSOR_TRIPPED;
+    if (payload == NULL) {
+        ThisEvent.EventParam = status;
+        EventMailbox_Post(PostTopHSM, ThisEvent);
+        return;
+    }
+    payload->timestamp = pair_time;
+    payload->status = status;
+    int i;
+    for (i = 0; i < NUM_TAPE_SENSORS; i++) {
+        payload->tape_diff[i] = frame.diff[i];
+    }
+    ThisEvent.EventParam = handle;
+    EventMailbox_Post(PostTopHSM, ThisEvent);
+}
+
+
+static void AccumulateCalibration(void) {
+    int i;
+    unsigned int reading;
+    for (i = 0; i < NUM_TAPE_SENSORS; i++) {
+        frame.diff[i] = frame.off[i] - frame.on[i];
+        reading = frame.diff[i] > TAPE_ADC_MAX ? TAPE_ADC_MAX : frame.diff[i];
+        if (cal_hist[i][reading >> CAL_BIN_SHIFT] < UINT16_MAX) {
+            cal_hist[i][reading >> CAL_BIN_SHIFT]++;
+        }
+    }
+}
+
+static void FinishCalibration(void) {
+    int32_t stored[NUM_TAPE_SENSORS][2];
+    int32_t black, white;
+    uint16_t black_threshold, white_threshold;
+    uint8_t split;
+    int i;
+
+    for (i = 0; i < NUM_TAPE_SENSORS; i++) {
+        split = FindClusters(cal_hist[i], &black, &white);
+        // the tier keeps drifting the frame, take the pair and thresholds
+        // from one state of it
+        SensorTier_Lock();
+        if (split) TapeFrame_SetClusters(&frame, i, black, white);
+        stored[i][0] = frame.black_mean[i];
+        stored[i][1] = frame.white_mean[i];
+        black_threshold = frame.black_threshold[i];
+        white_threshold = frame.white_threshold[i];
+        SensorTier_Unlock();
+        if (!split) {
+            printf("\r\nTape sensor %d: no clear tape/floor split, keeping old levels", i);
+        }
+        printf("\r\nTape sensor %d: black < %u, white > %u", i, black_threshold, white_threshold);
+    }
+    if (!FlashStore_Save(tape_cal_page, CAL_MAGIC, stored, sizeof (stored) / 4)) {
+        printf("\r\nTape calibration: flash write failed");
+    }
+}
+
+// Two cluster split of one sensor's histogram (iterative intersection
+// threshold): split, take the mean on either side, move the split to their
+// midpoint, repeat until it stops moving. Means are returned x16.
+static uint8_t FindClusters(const uint16_t *hist, int32_t *black, int32_t *white) {
+    uint32_t low_sum, low_count, high_sum, high_count, centre;
+    int split = CAL_BINS / 2, last_split = -1, bin, pass;
+
+    for (pass = 0; pass < CAL_BINS && split != last_split; pass++) {
+        low_sum = low_count = high_sum = high_count = 0;
+        for (bin = 0; bin < CAL_BINS; bin++) {
+            centre = (bin << CAL_BIN_SHIFT) + (1 << (CAL_BIN_SHIFT - 1));
+            if (bin < split) {
+                low_sum += centre * hist[bin];
+                low_count += hist[bin];
+            } else {
+                high_sum += centre * hist[bin];
+                high_count += hist[bin];
+            }
+        }
+        if (low_count == 0 || high_count == 0) return FALSE;
+        last_split = split;
+        split = ((low_sum / low_count + high_sum / high_count) / 2) >> CAL_BIN_SHIFT;
+    }
+    if (high_sum / high_count - low_sum / low_count < MIN_CAL_SEPARATION) return FALSE;
+    *black = (low_sum / low_count) << TAPE_MEAN_SHIFT;
+    *white = (high_sum / high_count) << TAPE_MEAN_SHIFT;
+    return TRUE;
+}
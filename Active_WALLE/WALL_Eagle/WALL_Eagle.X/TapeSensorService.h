@@ -24,13 +24,20 @@
  ******************************************************************************/
 
 #include "ES_Configure.h"   // defines ES_Event, INIT_EVENT, ENTRY_EVENT, and EXIT_EVENT
+#include "TapeFrame.h"
+#include "ADFrame.h"
 
 /*******************************************************************************
  * PUBLIC #DEFINES                                                             *
  ******************************************************************************/
+// defaults, used until a calibration record has been stored in flash
 #define WHITE_TAPE_THRESHOLD 800
 #define BLACK_TAPE_THRESHOLD 400
 
+// define to run the calibration sweep at every boot
+//#define TAPE_CALIBRATION
+#define CALIBRATION_TIME 5000 // ms to sweep the array over tape and floor
+
 //#define FAR_LEFT_TAPE_SENSOR_PIN AD_PORTW3
 //#define MID_LEFT_TAPE_SENSOR_PIN AD_PORTW4
 //#define MID_RIGHT_TAPE_SENSOR_PIN AD_PORTW5
@@ -43,27 +50,10 @@
  * PUBLIC TYPEDEFS                                                             *
  ******************************************************************************/
 typedef enum {
-    SAMPLE_FLASH_ON,
-    SAMPLE_TAKE_SAMPLE_1,
-    SAMPLE_FLASH_OFF,
-    SAMPLE_TAKE_SAMPLE_2,
+    SAMPLE_FLASH_ON,    // LEDs on, waiting for a lit frame
+    SAMPLE_FLASH_OFF,   // LEDs off, waiting for a dark frame
 } sampleState;
 
-typedef enum {
-    BLACK,
-    WHITE
-} tape_status;
-
-typedef struct tape_sensor tape_sensor;
-
-struct tape_sensor {
-    unsigned int sample1;
-    unsigned int sample2;
-    unsigned int diff;
-    tape_status status;
-    tape_status new_status;
-};
-
 
 /*******************************************************************************
  * PUBLIC FUNCTION PROTOTYPES                                                  *
@@ -107,11 +97,32 @@ uint8_t PostTapeSensorService(ES_Event ThisEvent);
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 ES_Event RunTapeSensorService(ES_Event ThisEvent);
 
+/**
+ * @Function TapeSensor_Demodulate(void)
+ * @return None
+ * @brief The TIER_TAPE actor (SensorTier.h). Runs the flash on/off cycle on
+ *        each captured frame and hands a changed status or the end of a
+ *        calibration sweep to the service. */
+void TapeSensor_Demodulate(void);
+
+/**
+ * @Function TapeSensor_StartCalibration(void)
+ * @return None
+ * @brief Starts a CALIBRATION_TIME ms sweep. Roll the array over tape and bare
+ *        floor; each sensor learns its own black and white levels and the
+ *        thresholds are saved to flash at the end. No TAPE_SENSOR_TRIPPED
+ *        events are posted while the sweep runs. */
+void TapeSensor_StartCalibration(void);
+
+/**
+ * @Function TapeSensor_IsCalibrating(void)
+ * @return TRUE while a calibration sweep is running */
+uint8_t TapeSensor_IsCalibrating(void);
+
 uint8_t dummy_func(void);
 
-void TakeFirstSample(void);
-void TakeSecondSample(void);
-void UpdateStatus(void);
+void TakeFirstSample(const ADFrame_t *sample);
+void TakeSecondSample(const ADFrame_t *sample);
 void AssembleReadings(void);
 
 #endif /* TapeSensorService_H */
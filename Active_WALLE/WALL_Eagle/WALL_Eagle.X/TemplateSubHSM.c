@@ -41,7 +41,7 @@ typedef enum {
     SubFirstState,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPSubState",
 	"SubFirstState",
 };
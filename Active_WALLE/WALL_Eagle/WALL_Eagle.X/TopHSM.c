@@ -37,6 +37,14 @@
 #include "ReloadSubHSM.h" //#include all sub state machines called
 #include "ScoreSubHSM.h"
 #include "DepositBallsSM.h"
+#include "EventPool.h"
+#include "EventMailbox.h"
+#include "EventLanes.h"
+#include "SerialTx.h"
+#include "StateStats.h"
+#include "motors.h"
+#include "WheelCalService.h"
+#include "BootProfile.h"
 /*******************************************************************************
  * PRIVATE #DEFINES                                                            *
  ******************************************************************************/
@@ -55,7 +63,7 @@ typedef enum {
     TestState,
 } TemplateHSMState_t;
 
-static const char *StateNames[] = {
+static const char * const StateNames[] = {
 	"InitPState",
 	"InitializationState",
 	"ReloadState",
@@ -70,6 +78,7 @@ static const char *StateNames[] = {
 /* Prototypes for private functions for this machine. They should be functions
    relevant to the behavior of this state machine
    Example: char RunAway(uint_8 seconds);*/
+static uint8_t QueueTopHSM(ES_Event ThisEvent);
 /*******************************************************************************
  * PRIVATE MODULE VARIABLES                                                            *
  ******************************************************************************/
@@ -77,7 +86,12 @@ static const char *StateNames[] = {
  * The type of state variable should match that of enum in header file. */
 
 static TemplateHSMState_t CurrentState = InitPState; // <- change enum name to match ENUM
+STATE_STATS(Stats, "TopHSM", StateNames);
 static uint8_t MyPriority;
+// bumps jump ahead of the tape and timer chatter, see EventLanes.h
+static EventLanes_t Lanes = EVENT_LANES("TopHSM");
+#define LaneOf(event) (((event).EventType == BUMPER_TRIPPED || \
+                        (event).EventType == BUMP_RESOLVED) ? LANE_URGENT : LANE_NORMAL)
 
 
 /*******************************************************************************
@@ -98,6 +112,7 @@ uint8_t InitTopHSM(uint8_t Priority) {
     MyPriority = Priority;
     // put us into the Initial PseudoState
     CurrentState = InitPState;
+    StateStats_Enter(&Stats, CurrentState);
     // post the initial transition event
     if (ES_PostToService(MyPriority, INIT_EVENT) == TRUE) {
         return TRUE;
@@ -116,7 +131,7 @@ uint8_t InitTopHSM(uint8_t Priority) {
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t PostTopHSM(ES_Event ThisEvent) {
-    return ES_PostToService(MyPriority, ThisEvent);
+    return EventLanes_Post(&Lanes, LaneOf(ThisEvent), QueueTopHSM, ThisEvent);
 }
 
 /**
@@ -135,16 +150,22 @@ uint8_t PostTopHSM(ES_Event ThisEvent) {
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunTopHSM(ES_Event ThisEvent) {
-    printf("\r\nCurrent: %s\tEvent: %s\tParam: 0x%04X",
+    ThisEvent = EventLanes_Take(&Lanes, ThisEvent); // urgent lane first
+    ThisEvent = EventMailbox_Collect(PostTopHSM, ThisEvent); // freshest tape reading
+    SerialTx_Printf("\r\nCurrent: %s\tEvent: %s\tParam: 0x%04X",
             StateNames[CurrentState], EventNames[ThisEvent.EventType], ThisEvent.EventParam);
     uint8_t makeTransition = FALSE; // use to flag transition
     TemplateHSMState_t nextState; // <- change type to correct enum
+    ES_Event ReceivedEvent = ThisEvent; // keep the handle, sub machines rewrite ThisEvent
 
     ES_Tattle(); // trace call stack
 
     switch (CurrentState) {
         case InitPState: // If current state is initial Pseudo State
-            if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
+            BootProfile_Mark(BOOT_TOP_HSM);
+            // only respond to ES_Init, WheelCalService posts it again once
+            // a calibration run has given the motors back
+            if (ThisEvent.EventType == ES_INIT && !WheelCal_IsRunning())
             {
                 // this is where you would put any actions associated with the
                 // transition from the initial pseudo-state into the actual
@@ -164,6 +185,7 @@ ES_Event RunTopHSM(ES_Event ThisEvent) {
             ThisEvent = RunInitSubHSM(ThisEvent);
             switch (ThisEvent.EventType){
                 case INIT_DONE:
+                    BootProfile_Mark(BOOT_INIT_DONE);
                     nextState = ReloadState;
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
@@ -180,7 +202,8 @@ ES_Event RunTopHSM(ES_Event ThisEvent) {
             ThisEvent = RunReloadSubHSM(ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitReloadSubHSM();
+                    // a reload run always starts over
+                    ResumeReloadSubHSM(HISTORY_NONE);
                     break;
                 case BALLS_LOADED:
                     nextState = ScoreState;
@@ -201,16 +224,14 @@ ES_Event RunTopHSM(ES_Event ThisEvent) {
             ThisEvent = RunScoreSubHSM(ThisEvent);
             switch (ThisEvent.EventType) {
                 case ES_ENTRY:
-                    InitScoreSubHSM();
+                    // a scoring run always starts over
+                    ResumeScoreSubHSM(HISTORY_NONE);
                     break;
                 case BALLS_EMPTY:
                     nextState = ReloadState;
                     makeTransition = TRUE;
                     ThisEvent.EventType = ES_NO_EVENT;
                     break;
-                case BALL_DROPPED:
-                    InitScoreSubHSM();
-                    break;
                 case ES_NO_EVENT:
                 default:
                     break;
@@ -241,10 +262,14 @@ ES_Event RunTopHSM(ES_Event ThisEvent) {
     if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
         // recursively call the current state with an exit event
         RunTopHSM(EXIT_EVENT); // <- rename to your own Run function
+        StateStats_Enter(&Stats, nextState);
         CurrentState = nextState;
         RunTopHSM(ENTRY_EVENT); // <- rename to your own Run function
     }
 
+    // this is the last stop for queued events, hand pool payloads back
+    EventPool_Consume(ReceivedEvent);
+
     ES_Tail(); // trace call stack end
     return ThisEvent;
 }
@@ -253,3 +278,8 @@ ES_Event RunTopHSM(ES_Event ThisEvent) {
 /*******************************************************************************
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
+
+// the real queue behind the lanes
+static uint8_t QueueTopHSM(ES_Event ThisEvent) {
+    return ES_PostToService(MyPriority, ThisEvent);
+}
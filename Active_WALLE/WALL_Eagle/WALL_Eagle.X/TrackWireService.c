@@ -13,6 +13,11 @@
 #include "IO_Ports.h"
 #include <stdio.h>
 #include "PinsMaster.h"
+#include "EventPool.h"
+#include "WorldState.h"
+#include "ADFrame.h"
+#include "SensorRate.h"
+#include "BootProfile.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
@@ -24,6 +29,9 @@
 #define TW_HIGH_THRESHOLD 900
 #define TW_LOW_THRESHOLD 600
 
+#define STARTUP_HOLD_TIME 500
+#define CHANGED_HOLD_TIME 20
+
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
  ******************************************************************************/
@@ -49,6 +57,9 @@ ES_EventTyp_t curEvent;
 uint16_t trackwire0_signal; // read the battery voltage
 uint16_t trackwire1_signal;
 
+static ADFrame_Reader_t reader;
+static uint8_t holding = TRUE;  // ignore frames until TRACK_WIRE_TIMER expires
+
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
  ******************************************************************************/
@@ -61,8 +72,9 @@ uint8_t InitTrackWireService(uint8_t Priority) {
 
     //AD_AddPins(AD_ActivePins() | LEFT_BUMPER_PIN | RIGHT_BUMPER_PIN);
 
-    // Start the timer and let it run expiring every 2 ms
-    ES_Timer_InitTimer(TRACK_WIRE_TIMER, 500);
+    // sampling runs off AD_FRAME_READY once the startup hold is over
+    ADFrame_Subscribe(PostTrackWireService);
+    ES_Timer_InitTimer(TRACK_WIRE_TIMER, STARTUP_HOLD_TIME);
 
     ThisEvent.EventType = ES_INIT;
     if (ES_PostToService(MyPriority, ThisEvent) == TRUE) {
@@ -85,6 +97,7 @@ ES_Event RunTrackWireService(ES_Event ThisEvent) {
      *******************************************/
     static ES_EventTyp_t lastEvent = WHITE_TAPE_DETECTED;
     ES_EventTyp_t curEvent;
+    const ADFrame_t *sample;
 
     switch (ThisEvent.EventType) {
         case ES_TIMERACTIVE:
@@ -93,16 +106,23 @@ ES_Event RunTrackWireService(ES_Event ThisEvent) {
             // go in the init function above.
             //
             // This section is used to reset service for some reason
+            BootProfile_Mark(BOOT_TRACK_WIRE_SERVICE);
             break;
 
         case ES_TIMEOUT:
             if (ThisEvent.EventParam == TRACK_WIRE_TIMER) {
-                //printf("*");
-                ES_Timer_InitTimer(TRACK_WIRE_TIMER, 5);
-                if (AD_IsNewDataReady()) {
+                holding = FALSE;
+            }
+            break;
+
+        case AD_FRAME_READY:
+            if (!holding && SensorRate_Due(SENSOR_TRACK_WIRE)) {
+                sample = ADFrame_Next(&reader);
+                if (sample != NULL) {
                     ES_Event thisEvent;
-                    trackwire0_signal = AD_ReadADPin(TW_DETECTOR_0_PIN); // read the battery voltage
-                    trackwire1_signal = AD_ReadADPin(TW_DETECTOR_1_PIN);
+                    BootProfile_Mark(BOOT_TRACK_WIRE_WARM);
+                    trackwire0_signal = ADFrame_Read(sample, TW_DETECTOR_0_PIN); // read the battery voltage
+                    trackwire1_signal = ADFrame_Read(sample, TW_DETECTOR_1_PIN);
                     //printf("|%d - %d|\n", trackwire0_signal, trackwire1_signal);
                     uint8_t tw0 = FALSE;
                     uint8_t tw1 = FALSE;
@@ -129,12 +149,24 @@ ES_Event RunTrackWireService(ES_Event ThisEvent) {
 
                     if (tw_status != new_tw_status) { // check for change from last time
                         //printf("lmao");
+                        uint16_t handle = EventPool_Alloc();
+                        SensorPayload_t *payload = EventPool_Get(handle);
                         tw_status = new_tw_status;
+                        WorldState_UpdateTrackWire(tw_status);
                         thisEvent.EventType = curEvent;
                         thisEvent.EventParam = tw_status;
                         lastEvent = curEvent; // update history
-                        ES_Timer_InitTimer(TRACK_WIRE_TIMER, 20);
-                        PostTopHSM(thisEvent);
+                        holding = TRUE;
+                        ES_Timer_InitTimer(TRACK_WIRE_TIMER, CHANGED_HOLD_TIME);
+                        if (payload != NULL) {
+                            payload->timestamp = ES_Timer_GetTime();
+                            payload->status = tw_status;
+                            payload->trackwire[0] = trackwire0_signal;
+                            payload->trackwire[1] = trackwire1_signal;
+                            EventPool_Post(PostTopHSM, curEvent, handle);
+                        } else {
+                            PostTopHSM(thisEvent);
+                        }
                     }
                     break;
                     //#ifdef SIMPLESERVICE_TEST     // keep this as is for test harness      
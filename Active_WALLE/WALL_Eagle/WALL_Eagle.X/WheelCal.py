@@ -0,0 +1,223 @@
+import sys
+import math
+import logging
+
+# WheelCal.py
+#
+# Runs the WheelCalService procedure (WheelCalService.c, same constants and
+# integer arithmetic) on a simulated robot with mismatched wheels, then drives
+# it open loop along the tape with BotDrive(v, 0), first with unity gains and
+# no deadband and then with the fitted values, and prints the cross-track
+# drift at the end of the tape for each. Fails if the fitted deadbands are
+# more than DeadbandTolerance off the simulated ones.
+#
+# The wheels follow speed = k * (duty - deadband), nothing below the deadband.
+# Tape status is exact and read every control tick, the robot has no inertia.
+#
+# usage: python WheelCal.py [-k left,right] [-d left,right] [-l tape length m]
+
+# robot, metres
+Track = 0.22
+SensorAhead = 0.12
+SensorOffsets = [0.045, 0.015, -0.015, -0.045]  # FL, ML, MR, FR, left positive
+SensorMasks = [0x1000, 0x0100, 0x0010, 0x0001]
+TapeWidth = 0.05    # the tape is y in [0, TapeWidth], its right edge on y = 0
+DefaultGains = (1.10e-3, 1.00e-3)   # m/s per duty unit
+DefaultDeadbands = (80, 130)
+DefaultLength = 2.5
+SubSteps = 20
+
+# WheelCalService.c and motors.h
+MaxSpeed = 1000
+GainOne = 32768
+TickTime = 0.020
+DeadbandStep = 5
+DeadbandLimit = 400
+CreepHold = 3
+CreepRamps = 3
+EdgeKick = 100
+TrimStep = 1
+RunTicks = 150
+RunSpeed = 400
+LostTicks = 25
+MR = 0x0010
+ML = 0x0100
+
+DeadbandTolerance = 2 * DeadbandStep
+
+
+# C division, truncates toward zero
+def cdiv(a, b):
+	q = abs(a) // abs(b)
+	return q if (a < 0) == (b < 0) else -q
+
+
+class Robot(object):
+
+	def __init__(self, gains, deadbands):
+		self.gains = gains
+		self.deadbands = deadbands
+		self.x = self.y = self.heading = 0.0
+		self.duty = [0, 0]
+
+	def wheelSpeed(self, wheel):
+		duty = self.duty[wheel]
+		over = max(0, abs(duty) - self.deadbands[wheel])
+		return math.copysign(self.gains[wheel] * over, duty)
+
+	def run(self, seconds):
+		dt = seconds / SubSteps
+		for i in range(SubSteps):
+			left, right = self.wheelSpeed(0), self.wheelSpeed(1)
+			v, turn = (left + right) / 2, (right - left) / Track
+			self.x += v * math.cos(self.heading) * dt
+			self.y += v * math.sin(self.heading) * dt
+			self.heading += turn * dt
+
+	def tape(self):
+		status = 0
+		for offset, mask in zip(SensorOffsets, SensorMasks):
+			y = self.y + SensorAhead * math.sin(self.heading) + offset * math.cos(self.heading)
+			if 0.0 <= y <= TapeWidth:
+				status |= mask
+		return status
+
+
+# the motor layer, motors.c
+class Motors(object):
+
+	def __init__(self, robot):
+		self.robot = robot
+		self.trims = [(0, GainOne), (0, GainOne)]
+
+	def calibrate(self, leftGain, leftDeadband, rightGain, rightDeadband):
+		self.trims = [(d, cdiv(g * (MaxSpeed - d), MaxSpeed)) for g, d in
+				((leftGain, leftDeadband), (rightGain, rightDeadband))]
+
+	def wheel(self, wheel, speed):
+		deadband, scale = self.trims[wheel]
+		duty = 0
+		if speed != 0:
+			duty = min(MaxSpeed, deadband + ((abs(speed) * scale) >> 15))
+		self.robot.duty[wheel] = duty if speed > 0 else -duty
+
+	def drive(self, v, w):
+		left, right = v - w, v + w
+		peak = max(abs(left), abs(right))
+		if peak > MaxSpeed:
+			scale = cdiv((MaxSpeed << 15) + peak - 1, peak)
+			left, right = cdiv(left * scale, 1 << 15), cdiv(right * scale, 1 << 15)
+		self.wheel(0, left)
+		self.wheel(1, right)
+
+
+# WheelCalService's run, returns (left gain, left deadband, right gain, right deadband) or None
+def calibrate(robot):
+	motors = Motors(robot)
+	tape = robot.tape()
+	if not (tape & ML) or (tape & MR):
+		logging.error('not on the tape edge')
+		return None
+
+	deadbands = []
+	for wheel in (0, 1):
+		# one fast ramp onto the edge, then held ramps back and forth over it
+		found = []
+		direction, start, hold = 1, 0, 1
+		for ramp in range(CreepRamps + 1):
+			reference = robot.tape()
+			duty = start
+			held = 0
+			while robot.tape() == reference:
+				if held == 0:
+					duty += DeadbandStep
+				held = 0 if held + 1 >= hold else held + 1
+				if duty > DeadbandLimit:
+					logging.error('wheel did not move')
+					return None
+				motors.wheel(wheel, direction * duty)
+				robot.run(TickTime)
+			motors.wheel(wheel, 0)
+			found.append(duty)
+			start = 0 if ramp == 0 else duty // 2 // DeadbandStep * DeadbandStep
+			direction, hold = -direction, CreepHold
+		deadbands.append(cdiv(found[-1] + found[-2], 2) - DeadbandStep // 2)
+
+	motors.calibrate(GainOne, deadbands[0], GainOne, deadbands[1])
+	trim = trimSum = lost = 0
+	for tick in range(1, RunTicks + 1):
+		tape = robot.tape()
+		kick = 0
+		if not (tape & ML):
+			kick = EdgeKick
+			trim += TrimStep
+		elif tape & MR:
+			kick = -EdgeKick
+			trim -= TrimStep
+		lost = 0 if tape & (ML | MR) else lost + 1
+		if lost == LostTicks:
+			logging.error('lost the tape')
+			return None
+		motors.drive(RunSpeed, trim + kick)
+		robot.run(TickTime)
+		if tick > RunTicks // 2:
+			trimSum += trim + kick
+	motors.drive(0, 0)
+
+	# WheelCalService.c Finish()
+	w = cdiv(trimSum, RunTicks - RunTicks // 2)
+	left, right = RunSpeed - w, RunSpeed + w
+	if left < right:
+		return (cdiv(GainOne * left, right), deadbands[0], GainOne, deadbands[1])
+	return (GainOne, deadbands[0], cdiv(GainOne * right, left), deadbands[1])
+
+
+def drift(robot, cal, v, length):
+	motors = Motors(robot)
+	if cal:
+		motors.calibrate(*cal)
+	motors.drive(v, 0)
+	# a robot that curves round never gets there, give up once it has gone far enough
+	for tick in range(int(3 * length / (v * min(robot.gains)) / TickTime)):
+		if robot.x >= length:
+			break
+		robot.run(TickTime)
+	return robot.y
+
+
+def main(argv):
+	gains = DefaultGains
+	deadbands = DefaultDeadbands
+	length = DefaultLength
+	args = list(argv)
+	while args:
+		arg = args.pop(0)
+		if arg == '-k':
+			gains = tuple(float(k) for k in args.pop(0).split(','))
+		elif arg == '-d':
+			deadbands = tuple(int(d) for d in args.pop(0).split(','))
+		elif arg == '-l':
+			length = float(args.pop(0))
+		else:
+			logging.error('unknown argument ' + arg)
+			return 1
+
+	cal = calibrate(Robot(gains, deadbands))
+	if cal is None:
+		return 1
+	logging.info('left gain %d/32768 deadband %d, right gain %d/32768 deadband %d' % cal)
+	for name, fitted, actual in (('left', cal[1], deadbands[0]), ('right', cal[3], deadbands[1])):
+		if abs(fitted - actual) > DeadbandTolerance:
+			logging.error('%s deadband %d, the simulated one is %d' % (name, fitted, actual))
+			return 1
+	for v in (400, 250):
+		raw = drift(Robot(gains, deadbands), None, v, length)
+		trimmed = drift(Robot(gains, deadbands), cal, v, length)
+		logging.info('v %d over %.1f m: drift %+.3f m raw, %+.3f m calibrated' % (v, length, raw, trimmed))
+	return 0
+
+
+if __name__ == '__main__':
+	logging.basicConfig(level=logging.INFO, format='[%(levelname)s]%(asctime)s: %(message)s',
+			stream=sys.stdout)
+	sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,303 @@
+/*
+ * File:   WheelCalService.c
+ *
+ * Wheel gain and deadband calibration run, see WheelCalService.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "ServiceHost.h"
+#include "WheelCalService.h"
+#include "TopHSM.h"
+#include "WorldState.h"
+#include "FlashStore.h"
+#include "motors.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+#define CAL_MAGIC 0x57484C31    // "WHL1", bump when the record layout changes
+
+#define TICK_TIME 20            // ms between control steps
+#define STARTUP_HOLD_TIME 700   // the tape service holds for 500 ms after boot
+#define DEADBAND_STEP 5         // duty added per tick while ramping a wheel
+#define DEADBAND_LIMIT 400      // a wheel that has not moved by here is stuck
+#define CREEP_HOLD 3            // ticks per step once the edge has been found
+#define CREEP_RAMPS 3           // held ramps over the edge, the last two count
+#define EDGE_KICK 100           // turn rate correction while off the edge
+#define TRIM_STEP 1             // integrator step per tick off the edge
+#define RUN_TICKS 150           // straight run, 3 s
+#define LOST_TICKS 25           // no tape under the middle sensors for this long
+
+// Tape Sensor Param Masks
+#define MR_MASK 0x0010
+#define ML_MASK 0x0100
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+typedef enum {
+    CalOff,
+    CalWaitSensors,
+    CalLocate,
+    CalCreep,
+    CalStraight,
+} CalState_t;
+
+typedef enum {
+    LEFT_WHEEL,
+    RIGHT_WHEEL,
+    NUM_WHEELS,
+} Wheel_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static void Step(void);
+static void DriveWheel(Wheel_t wheel, int speed);
+static void Finish(void);
+static void Abort(const char *why);
+static void Apply(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static uint8_t MyPriority;
+
+FLASH_STORE_PAGE(wheel_cal_page);
+
+// in the flash record order: gain and deadband, left then right
+static int32_t cal[NUM_WHEELS][2] = {
+    {MOTOR_GAIN_ONE, 0},
+    {MOTOR_GAIN_ONE, 0},
+};
+
+static CalState_t state = CalOff;
+static Wheel_t wheel;
+static uint16_t reference;      // tape status the ramp is waiting to change
+static int duty;
+static int direction;           // 1 forward, -1 backward
+static uint8_t held;            // ticks at this duty
+static uint8_t creeps;          // held ramps done on this wheel
+static int found[2];            // duty the last two held ramps moved at
+static int32_t deadband[NUM_WHEELS];
+static int trim;
+static int32_t trim_sum;
+static uint16_t ticks;
+static uint16_t lost;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t InitWheelCalService(uint8_t Priority) {
+    ES_Event ThisEvent;
+    uint8_t have_cal;
+
+    MyPriority = Priority;
+
+    have_cal = FlashStore_Load(wheel_cal_page, CAL_MAGIC, cal, sizeof (cal) / 4);
+    Apply();
+    printf("\r\nWheel trim from %s", have_cal ? "flash" : "defaults");
+#ifdef WHEEL_CALIBRATION
+    WheelCal_Start();
+#endif
+
+    ThisEvent.EventType = ES_INIT;
+    if (ServiceHost_Post(MyPriority, ThisEvent) == TRUE) {
+        return TRUE;
+    } else {
+        return FALSE;
+    }
+}
+
+uint8_t PostWheelCalService(ES_Event ThisEvent) {
+    return ServiceHost_Post(MyPriority, ThisEvent);
+}
+
+ES_Event RunWheelCalService(ES_Event ThisEvent) {
+    ES_Event ReturnEvent;
+    ReturnEvent.EventType = ES_NO_EVENT; // assume no errors
+
+    switch (ThisEvent.EventType) {
+        case ES_INIT:
+            break;
+
+        case ES_TIMEOUT:
+            if (state == CalOff) break;
+            Step();
+            if (state != CalOff) ES_Timer_InitTimer(WHEEL_CAL_TIMER, TICK_TIME);
+            break;
+
+        default:
+            break;
+    }
+    return ReturnEvent;
+}
+
+void WheelCal_Start(void) {
+    // measure raw wheels, the old values only come back if the run fails
+    SetMotorCalibration(MOTOR_GAIN_ONE, 0, MOTOR_GAIN_ONE, 0);
+    BotHalt();
+    state = CalWaitSensors;
+    ES_Timer_InitTimer(WHEEL_CAL_TIMER, STARTUP_HOLD_TIME);
+    printf("\r\nWheel calibration: on the tape edge, mid left on tape, mid right off");
+}
+
+uint8_t WheelCal_IsRunning(void) {
+    return state != CalOff;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+static void Step(void) {
+    uint16_t tape = WorldState_Tape();
+    int kick = 0;
+
+    switch (state) {
+        case CalWaitSensors:
+            if (!(tape & ML_MASK) || (tape & MR_MASK)) {
+                Abort("not on the tape edge");
+                break;
+            }
+            wheel = LEFT_WHEEL;
+            reference = tape;
+            duty = 0;
+            direction = 1;
+            held = 0;
+            creeps = 0;
+            state = CalLocate;
+            break;
+
+        // The wheel ramps up until the robot moves. The first ramp only
+        // brings a sensor onto the edge, it has a long way to go and the
+        // duty keeps climbing while it does. The held ramps then go back and
+        // forth over the edge from just past it, so the first step above the
+        // deadband is seen at once.
+        case CalLocate:
+        case CalCreep:
+            if (tape != reference) {
+                DriveWheel(wheel, 0);
+                reference = tape;
+                if (state == CalCreep) {
+                    found[creeps++ & 0x01] = duty;
+                }
+                if (creeps < CREEP_RAMPS) {
+                    duty = (state == CalLocate) ? 0 : duty / 2 / DEADBAND_STEP * DEADBAND_STEP;
+                    direction = -direction;
+                    held = 0;
+                    state = CalCreep;
+                    break;
+                }
+                // it moved somewhere within the last step
+                deadband[wheel] = (found[0] + found[1]) / 2 - DEADBAND_STEP / 2;
+                if (++wheel < NUM_WHEELS) {
+                    duty = 0;
+                    direction = 1;
+                    held = 0;
+                    creeps = 0;
+                    state = CalLocate;
+                    break;
+                }
+                SetMotorCalibration(MOTOR_GAIN_ONE, deadband[LEFT_WHEEL],
+                        MOTOR_GAIN_ONE, deadband[RIGHT_WHEEL]);
+                trim = 0;
+                trim_sum = 0;
+                ticks = 0;
+                lost = 0;
+                state = CalStraight;
+                break;
+            }
+            if (held == 0) duty += DEADBAND_STEP;
+            if (++held >= (state == CalCreep ? CREEP_HOLD : 1)) held = 0;
+            if (duty > DEADBAND_LIMIT) {
+                Abort("wheel did not move");
+                break;
+            }
+            DriveWheel(wheel, direction * duty);
+            break;
+
+        case CalStraight:
+            if (!(tape & ML_MASK)) {
+                kick = EDGE_KICK;       // drifted right of the edge
+                trim += TRIM_STEP;
+            } else if (tape & MR_MASK) {
+                kick = -EDGE_KICK;      // drifted left
+                trim -= TRIM_STEP;
+            }
+            lost = (tape & (ML_MASK | MR_MASK)) ? 0 : lost + 1;
+            if (lost == LOST_TICKS) {
+                Abort("lost the tape");
+                break;
+            }
+            BotDrive(WHEEL_CAL_SPEED, trim + kick);
+            // the trim needs the first half to settle, after that the mean
+            // of what was actually commanded is the turn rate
+            if (++ticks > RUN_TICKS / 2) trim_sum += trim + kick;
+            if (ticks == RUN_TICKS) Finish();
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void DriveWheel(Wheel_t wheel, int speed) {
+    if (wheel == LEFT_WHEEL) {
+        if (speed > 0) LeftMotorMoveForward(speed);
+        else if (speed < 0) LeftMotorMoveBackward(-speed);
+        else LeftMotorHalt();
+    } else {
+        if (speed > 0) RightMotorMoveForward(speed);
+        else if (speed < 0) RightMotorMoveBackward(-speed);
+        else RightMotorHalt();
+    }
+}
+
+// straight at v took v - w left and v + w right, the wheel that needed less
+// is the stronger one and is scaled down to the other
+static void Finish(void) {
+    ES_Event ThisEvent;
+    int32_t w = trim_sum / (RUN_TICKS - RUN_TICKS / 2);
+    int32_t left = WHEEL_CAL_SPEED - w, right = WHEEL_CAL_SPEED + w;
+
+    BotHalt();
+    cal[LEFT_WHEEL][0] = (left < right) ? (int32_t) MOTOR_GAIN_ONE * left / right : MOTOR_GAIN_ONE;
+    cal[RIGHT_WHEEL][0] = (left < right) ? MOTOR_GAIN_ONE : (int32_t) MOTOR_GAIN_ONE * right / left;
+    cal[LEFT_WHEEL][1] = deadband[LEFT_WHEEL];
+    cal[RIGHT_WHEEL][1] = deadband[RIGHT_WHEEL];
+    Apply();
+    printf("\r\nWheel calibration: left gain %ld/32768 deadband %ld, right gain %ld/32768 deadband %ld",
+            (long) cal[LEFT_WHEEL][0], (long) cal[LEFT_WHEEL][1],
+            (long) cal[RIGHT_WHEEL][0], (long) cal[RIGHT_WHEEL][1]);
+    if (!FlashStore_Save(wheel_cal_page, CAL_MAGIC, cal, sizeof (cal) / 4)) {
+        printf("\r\nWheel calibration: flash write failed");
+    }
+    state = CalOff;
+    ThisEvent.EventType = ES_INIT;
+    PostTopHSM(ThisEvent);
+}
+
+static void Abort(const char *why) {
+    ES_Event ThisEvent;
+
+    BotHalt();
+    Apply();
+    printf("\r\nWheel calibration: %s, keeping old values", why);
+    state = CalOff;
+    ThisEvent.EventType = ES_INIT;
+    PostTopHSM(ThisEvent);
+}
+
+static void Apply(void) {
+    SetMotorCalibration(cal[LEFT_WHEEL][0], cal[LEFT_WHEEL][1],
+            cal[RIGHT_WHEEL][0], cal[RIGHT_WHEEL][1]);
+}
@@ -0,0 +1,93 @@
+/*
+ * File:   WheelCalService.h
+ *
+ * Per wheel gain and static friction deadband. The two gearmotors do not
+ * turn at the same speed for the same duty, so BotMoveForward() curves and
+ * TapeFollowSM and ExclusionRadar spend their time correcting for it. The
+ * motor layer applies a gain and a deadband to each wheel
+ * (SetMotorCalibration() in motors.h); this service measures them and keeps
+ * them in flash.
+ *
+ * Put the robot on a straight piece of tape with the right edge of the tape
+ * between the mid left (on tape) and mid right (on floor) sensors and start
+ * a run, at boot with WHEEL_CALIBRATION defined or with WheelCal_Start():
+ *
+ *   1. Each wheel in turn ramps up from 0 until the tape status changes.
+ *      That first ramp only finds the edge: by the time a sensor has crossed
+ *      it the duty is well past the deadband. The wheel then ramps back and
+ *      forth over the edge from just past it, holding each step for a few
+ *      ticks, so the robot moves on the first step above the deadband. The
+ *      mean of the last two of these, less half a step, is the wheel's
+ *      deadband.
+ *   2. The robot drives along the edge at WHEEL_CAL_SPEED with the deadbands
+ *      applied. A bang-bang correction keeps it on the edge and an integrator
+ *      learns the steady turn rate w that holds it straight.
+ *   3. Straight at v takes v - w on the left and v + w on the right, so the
+ *      stronger wheel, the one that needed less, is scaled down by
+ *      (v - w) / (v + w) or its inverse.
+ *
+ * The result is applied, saved and printed, then TopHSM is started. TopHSM
+ * stays in its initial pseudo state while a run is going, so nothing else
+ * drives the motors. A run that cannot find the edge or never sees the robot
+ * move keeps the previous values.
+ *
+ * WheelCal.py runs the same procedure on a simulated robot and compares the
+ * cross-track drift with and without the fitted values.
+ */
+
+#ifndef WHEELCALSERVICE_H
+#define	WHEELCALSERVICE_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+// define to run the calibration at every boot
+//#define WHEEL_CALIBRATION
+#define WHEEL_CAL_SPEED 400     // straight run speed, PWM units
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function InitWheelCalService(uint8_t Priority)
+ * @param Priority - internal variable to track which event queue to use
+ * @return TRUE or FALSE
+ * @brief Applies the stored calibration, or unity gains and no deadband. */
+uint8_t InitWheelCalService(uint8_t Priority);
+
+/**
+ * @Function PostWheelCalService(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be posted to queue
+ * @return TRUE or FALSE */
+uint8_t PostWheelCalService(ES_Event ThisEvent);
+
+/**
+ * @Function RunWheelCalService(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be responded.
+ * @return ES_NO_EVENT */
+ES_Event RunWheelCalService(ES_Event ThisEvent);
+
+/**
+ * @Function WheelCal_Start(void)
+ * @return None
+ * @brief Starts a calibration run, the robot must be on the tape edge. */
+void WheelCal_Start(void);
+
+/**
+ * @Function WheelCal_IsRunning(void)
+ * @return TRUE while a calibration run owns the motors */
+uint8_t WheelCal_IsRunning(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* WHEELCALSERVICE_H */
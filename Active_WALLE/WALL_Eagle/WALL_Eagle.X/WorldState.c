@@ -0,0 +1,125 @@
+/*
+ * File:   WorldState.c
+ *
+ * Versioned store of the fused sensor state, see WorldState.h.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "WorldState.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+// the version is odd while a writer is part way through an update
+#define BeginUpdate() (world.version++)
+#define EndUpdate() do { world.timestamp = ES_Timer_GetTime(); world.version++; } while (0)
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+static uint8_t CountBits(uint16_t bits);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+static volatile WorldState_t world;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void WorldState_UpdateTape(uint16_t tape) {
+    if (tape == world.tape) return;
+    BeginUpdate();
+    world.tape = tape;
+    world.tape_count = CountBits(tape);
+    EndUpdate();
+}
+
+void WorldState_UpdateBumper(uint8_t bumper) {
+    if (bumper == world.bumper) return;
+    BeginUpdate();
+    world.bumper = bumper;
+    if (bumper) world.last_bump = bumper;
+    EndUpdate();
+}
+
+void WorldState_UpdateTrackWire(uint8_t track_wire) {
+    if (track_wire == world.track_wire) return;
+    BeginUpdate();
+    world.track_wire = track_wire;
+    EndUpdate();
+}
+
+void WorldState_UpdateBeacon(uint8_t beacon) {
+    if (beacon == world.beacon) return;
+    BeginUpdate();
+    world.beacon = beacon;
+    EndUpdate();
+}
+
+void WorldState_Snapshot(WorldState_t *snapshot) {
+    uint32_t version;
+    do {
+        version = world.version;
+        snapshot->version = version;
+        snapshot->timestamp = world.timestamp;
+        snapshot->tape = world.tape;
+        snapshot->tape_count = world.tape_count;
+        snapshot->bumper = world.bumper;
+        snapshot->last_bump = world.last_bump;
+        snapshot->track_wire = world.track_wire;
+        snapshot->beacon = world.beacon;
+    } while ((version & 0x01) || version != world.version);
+}
+
+uint32_t WorldState_Version(void) {
+    return world.version;
+}
+
+uint16_t WorldState_Tape(void) {
+    return world.tape;
+}
+
+uint8_t WorldState_TapeCount(void) {
+    return world.tape_count;
+}
+
+uint8_t WorldState_TapeOn(uint16_t mask) {
+    return (world.tape & mask) ? TRUE : FALSE;
+}
+
+uint8_t WorldState_Bumper(void) {
+    return world.bumper;
+}
+
+uint8_t WorldState_LastBump(void) {
+    return world.last_bump;
+}
+
+uint8_t WorldState_TrackWire(void) {
+    return world.track_wire;
+}
+
+uint8_t WorldState_Beacon(void) {
+    return world.beacon;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONs                                                           *
+ ******************************************************************************/
+
+static uint8_t CountBits(uint16_t bits) {
+    uint8_t count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+}
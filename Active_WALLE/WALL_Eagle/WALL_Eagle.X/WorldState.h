@@ -0,0 +1,90 @@
+/*
+ * File:   WorldState.h
+ *
+ * Single store for what the sensors currently say about the world. The sensor
+ * services write it once per frame as they decide a new status, before the
+ * matching event is posted; the state machines read it instead of keeping
+ * their own copies decoded from event parameters, which went stale whenever
+ * an event was consumed by a different layer.
+ *
+ * Every change bumps the version counter. WorldState_Snapshot() copies all
+ * fields as one consistent set (it retries if a writer got in between), the
+ * single field queries are O(1) reads.
+ */
+
+#ifndef WORLDSTATE_H
+#define	WORLDSTATE_H
+
+#include <stdint.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+// bumper status, same packing as BUMPER_TRIPPED
+#define BUMP_LEFT_MASK 0x10
+#define BUMP_RIGHT_MASK 0x01
+
+// track wire status, same packing as TRACK_WIRE_FOUND
+#define TW_DETECTOR_0_MASK 0x01
+#define TW_DETECTOR_1_MASK 0x10
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+typedef struct {
+    uint32_t version;    // even when stable, bumped on every change
+    uint32_t timestamp;  // ES_Timer_GetTime() of the last change
+    uint16_t tape;       // packed tape status, black = 1
+    uint8_t tape_count;  // number of tape sensors on black
+    uint8_t bumper;      // current bumper status
+    uint8_t last_bump;   // most recent non zero bumper status
+    uint8_t track_wire;  // current track wire status
+    uint8_t beacon;      // TRUE while the beacon is in view
+} WorldState_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function WorldState_UpdateTape(uint16_t tape)
+ * @brief Called by the sensor services with each new status, a status equal
+ *        to the stored one does not bump the version. The other updaters
+ *        work the same way. */
+void WorldState_UpdateTape(uint16_t tape);
+void WorldState_UpdateBumper(uint8_t bumper);
+void WorldState_UpdateTrackWire(uint8_t track_wire);
+void WorldState_UpdateBeacon(uint8_t beacon);
+
+/**
+ * @Function WorldState_Snapshot(WorldState_t *snapshot)
+ * @param snapshot - filled with a consistent copy of every field */
+void WorldState_Snapshot(WorldState_t *snapshot);
+
+/**
+ * @Function WorldState_Version(void)
+ * @return current version, compare against a snapshot to see if anything changed */
+uint32_t WorldState_Version(void);
+
+uint16_t WorldState_Tape(void);
+uint8_t WorldState_TapeCount(void);
+
+/**
+ * @Function WorldState_TapeOn(uint16_t mask)
+ * @return TRUE if any tape sensor in mask is on black */
+uint8_t WorldState_TapeOn(uint16_t mask);
+
+uint8_t WorldState_Bumper(void);
+uint8_t WorldState_LastBump(void);
+uint8_t WorldState_TrackWire(void);
+uint8_t WorldState_Beacon(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* WORLDSTATE_H */
@@ -0,0 +1,30 @@
+/*
+ * File:   AD.h
+ *
+ * Host stand-in for the CMPE118 AD.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef AD_H
+#define	AD_H
+
+#include <stdint.h>
+
+#define AD_PORTV3 (1 << 0)
+#define AD_PORTV4 (1 << 1)
+#define AD_PORTV5 (1 << 2)
+#define AD_PORTV6 (1 << 3)
+#define AD_PORTV7 (1 << 4)
+#define AD_PORTV8 (1 << 5)
+#define AD_PORTW3 (1 << 6)
+#define AD_PORTW4 (1 << 7)
+#define AD_PORTW5 (1 << 8)
+#define AD_PORTW6 (1 << 9)
+#define BAT_VOLTAGE (1 << 12)
+
+char AD_AddPins(unsigned int AddPins);
+char AD_RemovePins(unsigned int RemovePins);
+unsigned int AD_ReadADPin(unsigned int Pin);
+
+#endif	/* AD_H */
@@ -0,0 +1,21 @@
+/*
+ * File:   BOARD.h
+ *
+ * Host stand-in for the CMPE118 BOARD.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef BOARD_H
+#define	BOARD_H
+
+#include <stdint.h>
+
+#define TRUE 1
+#define FALSE 0
+#define ERROR ((int8_t) -1)
+#define SUCCESS 1
+
+void BOARD_Init(void);
+
+#endif	/* BOARD_H */
@@ -0,0 +1,163 @@
+/*
+ * File:   BenchStubs.c
+ *
+ * Host stand-ins for the framework, the CMPE118 drivers and the hardware
+ * facing modules, so Bench.c can link the state machines and services as
+ * they are. Nothing here is ever serviced: posts and timers are accepted and
+ * dropped, the clock does not move, the pins read 0 and flash is empty. The
+ * benchmarks only measure the code between these calls.
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "AD.h"
+#include "IO_Ports.h"
+#include "RC_Servo.h"
+#include "pwm.h"
+#include "serial.h"
+#include "timers.h"
+#include "ADFrame.h"
+#include "SensorTier.h"
+#include "FlashStore.h"
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t ES_PostToService(uint8_t WhichService, ES_Event TheEvent) {
+    (void) WhichService;
+    (void) TheEvent;
+    return TRUE;
+}
+
+ES_TimerReturn_t ES_Timer_InitTimer(uint8_t Num, uint32_t NewTime) {
+    (void) Num;
+    (void) NewTime;
+    return ES_Timer_OK;
+}
+
+ES_TimerReturn_t ES_Timer_StopTimer(uint8_t Num) {
+    (void) Num;
+    return ES_Timer_OK;
+}
+
+uint32_t ES_Timer_GetTime(void) {
+    return 0;
+}
+
+char AD_AddPins(unsigned int AddPins) {
+    (void) AddPins;
+    return SUCCESS;
+}
+
+char AD_RemovePins(unsigned int RemovePins) {
+    (void) RemovePins;
+    return SUCCESS;
+}
+
+unsigned int AD_ReadADPin(unsigned int Pin) {
+    (void) Pin;
+    return 0;
+}
+
+int8_t IO_PortsSetPortOutputs(int port, uint16_t pattern) {
+    (void) port;
+    (void) pattern;
+    return SUCCESS;
+}
+
+int8_t IO_PortsSetPortBits(int port, uint16_t pattern) {
+    (void) port;
+    (void) pattern;
+    return SUCCESS;
+}
+
+int8_t IO_PortsClearPortBits(int port, uint16_t pattern) {
+    (void) port;
+    (void) pattern;
+    return SUCCESS;
+}
+
+char RC_SetPulseTime(unsigned short WhichPin, unsigned short Time) {
+    (void) WhichPin;
+    (void) Time;
+    return SUCCESS;
+}
+
+char PWM_Init(void) {
+    return SUCCESS;
+}
+
+char PWM_AddPins(unsigned char AddPins) {
+    (void) AddPins;
+    return SUCCESS;
+}
+
+char PWM_SetFrequency(unsigned int NewFrequency) {
+    (void) NewFrequency;
+    return SUCCESS;
+}
+
+char PWM_SetDutyCycle(unsigned char Channel, unsigned int Duty) {
+    (void) Channel;
+    (void) Duty;
+    return SUCCESS;
+}
+
+void PutChar(char ch) {
+    (void) ch;
+}
+
+// nothing drains the SerialTx ring here, what does not fit is dropped
+char IsTransmitEmpty(void) {
+    return FALSE;
+}
+
+void TIMERS_Init(void) {
+}
+
+const ADFrame_t *ADFrame_Next(ADFrame_Reader_t *reader) {
+    (void) reader;
+    return 0;
+}
+
+uint16_t ADFrame_Read(const ADFrame_t *frame, uint32_t pin) {
+    (void) frame;
+    (void) pin;
+    return 0;
+}
+
+uint32_t ADFrame_Sequence(void) {
+    return 0;
+}
+
+uint8_t SensorTier_Post(uint8_t(*PostFunction)(ES_Event), ES_Event ThisEvent) {
+    return PostFunction(ThisEvent);
+}
+
+void SensorTier_Lock(void) {
+}
+
+void SensorTier_Unlock(void) {
+}
+
+uint8_t FlashStore_Load(const uint32_t *page, uint32_t magic, void *data, uint16_t words) {
+    (void) page;
+    (void) magic;
+    (void) data;
+    (void) words;
+    return FALSE;
+}
+
+uint8_t FlashStore_Save(const uint32_t *page, uint32_t magic, const void *data, uint16_t words) {
+    (void) page;
+    (void) magic;
+    (void) data;
+    (void) words;
+    return FALSE;
+}
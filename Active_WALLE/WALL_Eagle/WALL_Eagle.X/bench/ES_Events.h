@@ -0,0 +1,24 @@
+/*
+ * File:   ES_Events.h
+ *
+ * Host stand-in for the ES_Framework ES_Events.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef ES_EVENTS_H
+#define	ES_EVENTS_H
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+typedef struct ES_Event {
+    ES_EventTyp_t EventType;
+    uint16_t EventParam;
+} ES_Event;
+
+#define INIT_EVENT ((ES_Event) {ES_INIT, 0x0000})
+#define ENTRY_EVENT ((ES_Event) {ES_ENTRY, 0x0000})
+#define EXIT_EVENT ((ES_Event) {ES_EXIT, 0x0000})
+
+#endif	/* ES_EVENTS_H */
@@ -0,0 +1,24 @@
+/*
+ * File:   ES_Framework.h
+ *
+ * Host stand-in for the ES_Framework ES_Framework.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef ES_FRAMEWORK_H
+#define	ES_FRAMEWORK_H
+
+#include <stdint.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "ES_Timers.h"
+#include "ES_ServiceHeaders.h"
+
+#define ES_Tattle()
+#define ES_Tail()
+
+uint8_t ES_PostToService(uint8_t WhichService, ES_Event TheEvent);
+
+#endif	/* ES_FRAMEWORK_H */
@@ -0,0 +1,19 @@
+/*
+ * File:   ES_KeyboardInput.h
+ *
+ * Host stand-in for the ES_Framework ES_KeyboardInput.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef ES_KEYBOARDINPUT_H
+#define	ES_KEYBOARDINPUT_H
+
+#include <stdint.h>
+#include "ES_Events.h"
+
+uint8_t InitKeyboardInput(uint8_t Priority);
+uint8_t PostKeyboardInput(ES_Event ThisEvent);
+ES_Event RunKeyboardInput(ES_Event ThisEvent);
+
+#endif	/* ES_KEYBOARDINPUT_H */
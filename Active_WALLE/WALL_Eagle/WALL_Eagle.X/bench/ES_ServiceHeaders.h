@@ -0,0 +1,37 @@
+/*
+ * File:   ES_ServiceHeaders.h
+ *
+ * Host stand-in for the ES_Framework ES_ServiceHeaders.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef ES_SERVICEHEADERS_H
+#define	ES_SERVICEHEADERS_H
+
+#include "ES_Configure.h"
+
+#include SERV_0_HEADER
+#if NUM_SERVICES > 1
+#include SERV_1_HEADER
+#endif
+#if NUM_SERVICES > 2
+#include SERV_2_HEADER
+#endif
+#if NUM_SERVICES > 3
+#include SERV_3_HEADER
+#endif
+#if NUM_SERVICES > 4
+#include SERV_4_HEADER
+#endif
+#if NUM_SERVICES > 5
+#include SERV_5_HEADER
+#endif
+#if NUM_SERVICES > 6
+#include SERV_6_HEADER
+#endif
+#if NUM_SERVICES > 7
+#include SERV_7_HEADER
+#endif
+
+#endif	/* ES_SERVICEHEADERS_H */
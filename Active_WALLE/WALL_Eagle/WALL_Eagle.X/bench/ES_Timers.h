@@ -0,0 +1,22 @@
+/*
+ * File:   ES_Timers.h
+ *
+ * Host stand-in for the ES_Framework ES_Timers.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef ES_TIMERS_H
+#define	ES_TIMERS_H
+
+#include <stdint.h>
+
+typedef enum {
+    ES_Timer_ERR = -1, ES_Timer_ACTIVE = 1, ES_Timer_OK = 0, ES_Timer_NOT_ACTIVE = 0
+} ES_TimerReturn_t;
+
+ES_TimerReturn_t ES_Timer_InitTimer(uint8_t Num, uint32_t NewTime);
+ES_TimerReturn_t ES_Timer_StopTimer(uint8_t Num);
+uint32_t ES_Timer_GetTime(void);
+
+#endif	/* ES_TIMERS_H */
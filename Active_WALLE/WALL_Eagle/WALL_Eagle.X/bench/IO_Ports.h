@@ -0,0 +1,25 @@
+/*
+ * File:   IO_Ports.h
+ *
+ * Host stand-in for the CMPE118 IO_Ports.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef IO_PORTS_H
+#define	IO_PORTS_H
+
+#include <stdint.h>
+
+enum {
+    PORTW, PORTX, PORTY, PORTZ
+};
+#define PIN7 (1 << 7)
+#define PIN9 (1 << 9)
+#define PIN11 (1 << 11)
+
+int8_t IO_PortsSetPortOutputs(int port, uint16_t pattern);
+int8_t IO_PortsSetPortBits(int port, uint16_t pattern);
+int8_t IO_PortsClearPortBits(int port, uint16_t pattern);
+
+#endif	/* IO_PORTS_H */
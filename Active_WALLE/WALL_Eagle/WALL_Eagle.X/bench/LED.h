@@ -0,0 +1,14 @@
+/*
+ * File:   LED.h
+ *
+ * Host stand-in for the CMPE118 LED.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef LED_H
+#define	LED_H
+
+#include <stdint.h>
+
+#endif	/* LED_H */
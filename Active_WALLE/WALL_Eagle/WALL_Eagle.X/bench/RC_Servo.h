@@ -0,0 +1,19 @@
+/*
+ * File:   RC_Servo.h
+ *
+ * Host stand-in for the CMPE118 RC_Servo.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef RC_SERVO_H
+#define	RC_SERVO_H
+
+#include <stdint.h>
+
+#define RC_PORTY06 (1 << 0)
+#define RC_PORTY07 (1 << 1)
+
+char RC_SetPulseTime(unsigned short WhichPin, unsigned short Time);
+
+#endif	/* RC_SERVO_H */
@@ -0,0 +1,24 @@
+/*
+ * File:   pwm.h
+ *
+ * Host stand-in for the CMPE118 pwm.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef PWM_H
+#define	PWM_H
+
+#include <stdint.h>
+
+#define PWM_PORTY10 (1 << 2)
+#define PWM_PORTY12 (1 << 3)
+#define MAX_PWM 1000
+#define MIN_PWM 0
+
+char PWM_Init(void);
+char PWM_AddPins(unsigned char AddPins);
+char PWM_SetFrequency(unsigned int NewFrequency);
+char PWM_SetDutyCycle(unsigned char Channel, unsigned int Duty);
+
+#endif	/* PWM_H */
@@ -0,0 +1,17 @@
+/*
+ * File:   serial.h
+ *
+ * Host stand-in for the CMPE118 serial.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef SERIAL_H
+#define	SERIAL_H
+
+#include <stdint.h>
+
+void PutChar(char ch);
+char IsTransmitEmpty(void);
+
+#endif	/* SERIAL_H */
@@ -0,0 +1,16 @@
+/*
+ * File:   timers.h
+ *
+ * Host stand-in for the CMPE118 timers.h.
+ * Only what the benchmarked modules use. Bench.py puts this directory on the
+ * include path, MPLAB never sees it.
+ */
+
+#ifndef TIMERS_H
+#define	TIMERS_H
+
+#include <stdint.h>
+
+void TIMERS_Init(void);
+
+#endif	/* TIMERS_H */
@@ -6,18 +6,27 @@
 #include "AD.h"
 #include "EventChecker.h"
 #include "PinsMaster.h"
+#include "SensorTier.h"
+#include "BootProfile.h"
 
+#ifndef CYCLE_BENCH // CycleBench.c has its own main
 void main(void)
 {
     ES_Return_t ErrorType;
 
+    BootProfile_Start();
     BOARD_Init();
+    BootProfile_Mark(BOOT_BOARD_INIT);
     AD_Init();
+    BootProfile_Mark(BOOT_AD_INIT);
     PWM_Init();
+    BootProfile_Mark(BOOT_PWM_INIT);
     RC_Init();
+    BootProfile_Mark(BOOT_RC_INIT);
 
     printf("Starting ES Framework Template\r\n");
     printf("using the 2nd Generation Events & Services Framework\r\n");
+    BootProfile_Mark(BOOT_BANNER);
 
 
     // Your hardware initialization function calls go here
@@ -30,12 +39,16 @@ void main(void)
     RC_AddPins(RC_PIN_LIST);
     RC_SetPulseTime(SERVO_0_OUT_PIN,1000);
     RC_SetPulseTime(SERVO_1_OUT_PIN,1000);
+    BootProfile_Mark(BOOT_PINS);
     
     
 
     // now initialize the Events and Services Framework and start it running
     ErrorType = ES_Initialize();
+    BootProfile_Mark(BOOT_ES_INITIALIZE);
     if (ErrorType == Success) {
+        SensorTier_Init();
+        BootProfile_Mark(BOOT_ES_RUN);
         ErrorType = ES_Run();
 
     }
@@ -55,6 +68,7 @@ void main(void)
         ;
 
 };
+#endif
 
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
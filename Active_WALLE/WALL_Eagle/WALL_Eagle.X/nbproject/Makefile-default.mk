@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=C:/CMPE118/src/AD.c C:/CMPE118/src/BOARD.c C:/CMPE118/src/IO_Ports.c C:/CMPE118/src/LED.c C:/CMPE118/src/RC_Servo.c C:/CMPE118/src/pwm.c C:/CMPE118/src/serial.c C:/CMPE118/src/timers.c C:/CMPE118/src/ES_CheckEvents.c C:/CMPE118/src/ES_Framework.c C:/CMPE118/src/ES_KeyboardInput.c C:/CMPE118/src/ES_PostList.c C:/CMPE118/src/ES_Queue.c C:/CMPE118/src/ES_TattleTale.c C:/CMPE118/src/ES_Timers.c TapeSensorService.c main.c EventChecker.c BaseFSM.c TemplateService.c TemplateSubHSM.c TopHSM.c ReloadSubHSM.c ../Motor_test/motors.c TapeFollowSM.c BumperService.c BumpResService.c ReceiveService.c ScoreSubHSM.c TrackWireService.c InitSubHSM.c DepositBallsSM.c ExclusionRadar.c BatteryAdjust.c
+SOURCEFILES_QUOTED_IF_SPACED=C:/CMPE118/src/AD.c C:/CMPE118/src/BOARD.c C:/CMPE118/src/IO_Ports.c C:/CMPE118/src/LED.c C:/CMPE118/src/RC_Servo.c C:/CMPE118/src/pwm.c C:/CMPE118/src/serial.c C:/CMPE118/src/timers.c C:/CMPE118/src/ES_CheckEvents.c C:/CMPE118/src/ES_Framework.c C:/CMPE118/src/ES_KeyboardInput.c C:/CMPE118/src/ES_PostList.c C:/CMPE118/src/ES_Queue.c C:/CMPE118/src/ES_TattleTale.c C:/CMPE118/src/ES_Timers.c TapeSensorService.c main.c EventChecker.c BaseFSM.c TemplateService.c TemplateSubHSM.c TopHSM.c ReloadSubHSM.c ../Motor_test/motors.c TapeFollowSM.c BumperService.c BumpResService.c ReceiveService.c ScoreSubHSM.c TrackWireService.c InitSubHSM.c DepositBallsSM.c ExclusionRadar.c BatteryAdjust.c ES_Names.c EventPool.c FlashStore.c TapeFrame.c WorldState.c StateStats.c HSMHistory.c HSMDefer.c ADFrame.c SensorRate.c CycleBench.c HIL.c EventMailbox.c EventLanes.c ServiceHost.c ES_Hosted.c Idle.c SerialTx.c SensorTier.c WheelCalService.c HSMSupervisor.c BootProfile.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/331920610/AD.o ${OBJECTDIR}/_ext/331920610/BOARD.o ${OBJECTDIR}/_ext/331920610/IO_Ports.o ${OBJECTDIR}/_ext/331920610/LED.o ${OBJECTDIR}/_ext/331920610/RC_Servo.o ${OBJECTDIR}/_ext/331920610/pwm.o ${OBJECTDIR}/_ext/331920610/serial.o ${OBJECTDIR}/_ext/331920610/timers.o ${OBJECTDIR}/_ext/331920610/ES_CheckEvents.o ${OBJECTDIR}/_ext/331920610/ES_Framework.o ${OBJECTDIR}/_ext/331920610/ES_KeyboardInput.o ${OBJECTDIR}/_ext/331920610/ES_PostList.o ${OBJECTDIR}/_ext/331920610/ES_Queue.o ${OBJECTDIR}/_ext/331920610/ES_TattleTale.o ${OBJECTDIR}/_ext/331920610/ES_Timers.o ${OBJECTDIR}/TapeSensorService.o ${OBJECTDIR}/main.o ${OBJECTDIR}/EventChecker.o ${OBJECTDIR}/BaseFSM.o ${OBJECTDIR}/TemplateService.o ${OBJECTDIR}/TemplateSubHSM.o ${OBJECTDIR}/TopHSM.o ${OBJECTDIR}/ReloadSubHSM.o ${OBJECTDIR}/_ext/554456555/motors.o ${OBJECTDIR}/TapeFollowSM.o ${OBJECTDIR}/BumperService.o ${OBJECTDIR}/BumpResService.o ${OBJECTDIR}/ReceiveService.o ${OBJECTDIR}/ScoreSubHSM.o ${OBJECTDIR}/TrackWireService.o ${OBJECTDIR}/InitSubHSM.o ${OBJECTDIR}/DepositBallsSM.o ${OBJECTDIR}/ExclusionRadar.o ${OBJECTDIR}/BatteryAdjust.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/331920610/AD.o.d ${OBJECTDIR}/_ext/331920610/BOARD.o.d ${OBJECTDIR}/_ext/331920610/IO_Ports.o.d ${OBJECTDIR}/_ext/331920610/LED.o.d ${OBJECTDIR}/_ext/331920610/RC_Servo.o.d ${OBJECTDIR}/_ext/331920610/pwm.o.d ${OBJECTDIR}/_ext/331920610/serial.o.d ${OBJECTDIR}/_ext/331920610/timers.o.d ${OBJECTDIR}/_ext/331920610/ES_CheckEvents.o.d ${OBJECTDIR}/_ext/331920610/ES_Framework.o.d ${OBJECTDIR}/_ext/331920610/ES_KeyboardInput.o.d ${OBJECTDIR}/_ext/331920610/ES_PostList.o.d ${OBJECTDIR}/_ext/331920610/ES_Queue.o.d ${OBJECTDIR}/_ext/331920610/ES_TattleTale.o.d ${OBJECTDIR}/_ext/331920610/ES_Timers.o.d ${OBJECTDIR}/TapeSensorService.o.d ${OBJECTDIR}/main.o.d ${OBJECTDIR}/EventChecker.o.d ${OBJECTDIR}/BaseFSM.o.d ${OBJECTDIR}/TemplateService.o.d ${OBJECTDIR}/TemplateSubHSM.o.d ${OBJECTDIR}/TopHSM.o.d ${OBJECTDIR}/ReloadSubHSM.o.d ${OBJECTDIR}/_ext/554456555/motors.o.d ${OBJECTDIR}/TapeFollowSM.o.d ${OBJECTDIR}/BumperService.o.d ${OBJECTDIR}/BumpResService.o.d ${OBJECTDIR}/ReceiveService.o.d ${OBJECTDIR}/ScoreSubHSM.o.d ${OBJECTDIR}/TrackWireService.o.d ${OBJECTDIR}/InitSubHSM.o.d ${OBJECTDIR}/DepositBallsSM.o.d ${OBJECTDIR}/ExclusionRadar.o.d ${OBJECTDIR}/BatteryAdjust.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/331920610/AD.o ${OBJECTDIR}/_ext/331920610/BOARD.o ${OBJECTDIR}/_ext/331920610/IO_Ports.o ${OBJECTDIR}/_ext/331920610/LED.o ${OBJECTDIR}/_ext/331920610/RC_Servo.o ${OBJECTDIR}/_ext/331920610/pwm.o ${OBJECTDIR}/_ext/331920610/serial.o ${OBJECTDIR}/_ext/331920610/timers.o ${OBJECTDIR}/_ext/331920610/ES_CheckEvents.o ${OBJECTDIR}/_ext/331920610/ES_Framework.o ${OBJECTDIR}/_ext/331920610/ES_KeyboardInput.o ${OBJECTDIR}/_ext/331920610/ES_PostList.o ${OBJECTDIR}/_ext/331920610/ES_Queue.o ${OBJECTDIR}/_ext/331920610/ES_TattleTale.o ${OBJECTDIR}/_ext/331920610/ES_Timers.o ${OBJECTDIR}/TapeSensorService.o ${OBJECTDIR}/main.o ${OBJECTDIR}/EventChecker.o ${OBJECTDIR}/BaseFSM.o ${OBJECTDIR}/TemplateService.o ${OBJECTDIR}/TemplateSubHSM.o ${OBJECTDIR}/TopHSM.o ${OBJECTDIR}/ReloadSubHSM.o ${OBJECTDIR}/_ext/554456555/motors.o ${OBJECTDIR}/TapeFollowSM.o ${OBJECTDIR}/BumperService.o ${OBJECTDIR}/BumpResService.o ${OBJECTDIR}/ReceiveService.o ${OBJECTDIR}/ScoreSubHSM.o ${OBJECTDIR}/TrackWireService.o ${OBJECTDIR}/InitSubHSM.o ${OBJECTDIR}/DepositBallsSM.o ${OBJECTDIR}/ExclusionRadar.o ${OBJECTDIR}/BatteryAdjust.o ${OBJECTDIR}/ES_Names.o ${OBJECTDIR}/EventPool.o ${OBJECTDIR}/FlashStore.o ${OBJECTDIR}/TapeFrame.o ${OBJECTDIR}/WorldState.o ${OBJECTDIR}/StateStats.o ${OBJECTDIR}/HSMHistory.o ${OBJECTDIR}/HSMDefer.o ${OBJECTDIR}/ADFrame.o ${OBJECTDIR}/SensorRate.o ${OBJECTDIR}/CycleBench.o ${OBJECTDIR}/HIL.o ${OBJECTDIR}/EventMailbox.o ${OBJECTDIR}/EventLanes.o ${OBJECTDIR}/ServiceHost.o ${OBJECTDIR}/ES_Hosted.o ${OBJECTDIR}/Idle.o ${OBJECTDIR}/SerialTx.o ${OBJECTDIR}/SensorTier.o ${OBJECTDIR}/WheelCalService.o ${OBJECTDIR}/HSMSupervisor.o ${OBJECTDIR}/BootProfile.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/331920610/AD.o.d ${OBJECTDIR}/_ext/331920610/BOARD.o.d ${OBJECTDIR}/_ext/331920610/IO_Ports.o.d ${OBJECTDIR}/_ext/331920610/LED.o.d ${OBJECTDIR}/_ext/331920610/RC_Servo.o.d ${OBJECTDIR}/_ext/331920610/pwm.o.d ${OBJECTDIR}/_ext/331920610/serial.o.d ${OBJECTDIR}/_ext/331920610/timers.o.d ${OBJECTDIR}/_ext/331920610/ES_CheckEvents.o.d ${OBJECTDIR}/_ext/331920610/ES_Framework.o.d ${OBJECTDIR}/_ext/331920610/ES_KeyboardInput.o.d ${OBJECTDIR}/_ext/331920610/ES_PostList.o.d ${OBJECTDIR}/_ext/331920610/ES_Queue.o.d ${OBJECTDIR}/_ext/331920610/ES_TattleTale.o.d ${OBJECTDIR}/_ext/331920610/ES_Timers.o.d ${OBJECTDIR}/TapeSensorService.o.d ${OBJECTDIR}/main.o.d ${OBJECTDIR}/EventChecker.o.d ${OBJECTDIR}/BaseFSM.o.d ${OBJECTDIR}/TemplateService.o.d ${OBJECTDIR}/TemplateSubHSM.o.d ${OBJECTDIR}/TopHSM.o.d ${OBJECTDIR}/ReloadSubHSM.o.d ${OBJECTDIR}/_ext/554456555/motors.o.d ${OBJECTDIR}/TapeFollowSM.o.d ${OBJECTDIR}/BumperService.o.d ${OBJECTDIR}/BumpResService.o.d ${OBJECTDIR}/ReceiveService.o.d ${OBJECTDIR}/ScoreSubHSM.o.d ${OBJECTDIR}/TrackWireService.o.d ${OBJECTDIR}/InitSubHSM.o.d ${OBJECTDIR}/DepositBallsSM.o.d ${OBJECTDIR}/ExclusionRadar.o.d ${OBJECTDIR}/BatteryAdjust.o.d ${OBJECTDIR}/ES_Names.o.d ${OBJECTDIR}/EventPool.o.d ${OBJECTDIR}/FlashStore.o.d ${OBJECTDIR}/TapeFrame.o.d ${OBJECTDIR}/WorldState.o.d ${OBJECTDIR}/StateStats.o.d ${OBJECTDIR}/HSMHistory.o.d ${OBJECTDIR}/HSMDefer.o.d ${OBJECTDIR}/ADFrame.o.d ${OBJECTDIR}/SensorRate.o.d ${OBJECTDIR}/CycleBench.o.d ${OBJECTDIR}/HIL.o.d ${OBJECTDIR}/EventMailbox.o.d ${OBJECTDIR}/EventLanes.o.d ${OBJECTDIR}/ServiceHost.o.d ${OBJECTDIR}/ES_Hosted.o.d ${OBJECTDIR}/Idle.o.d ${OBJECTDIR}/SerialTx.o.d ${OBJECTDIR}/SensorTier.o.d ${OBJECTDIR}/WheelCalService.o.d ${OBJECTDIR}/HSMSupervisor.o.d ${OBJECTDIR}/BootProfile.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/331920610/AD.o ${OBJECTDIR}/_ext/331920610/BOARD.o ${OBJECTDIR}/_ext/331920610/IO_Ports.o ${OBJECTDIR}/_ext/331920610/LED.o ${OBJECTDIR}/_ext/331920610/RC_Servo.o ${OBJECTDIR}/_ext/331920610/pwm.o ${OBJECTDIR}/_ext/331920610/serial.o ${OBJECTDIR}/_ext/331920610/timers.o ${OBJECTDIR}/_ext/331920610/ES_CheckEvents.o ${OBJECTDIR}/_ext/331920610/ES_Framework.o ${OBJECTDIR}/_ext/331920610/ES_KeyboardInput.o ${OBJECTDIR}/_ext/331920610/ES_PostList.o ${OBJECTDIR}/_ext/331920610/ES_Queue.o ${OBJECTDIR}/_ext/331920610/ES_TattleTale.o ${OBJECTDIR}/_ext/331920610/ES_Timers.o ${OBJECTDIR}/TapeSensorService.o ${OBJECTDIR}/main.o ${OBJECTDIR}/EventChecker.o ${OBJECTDIR}/BaseFSM.o ${OBJECTDIR}/TemplateService.o ${OBJECTDIR}/TemplateSubHSM.o ${OBJECTDIR}/TopHSM.o ${OBJECTDIR}/ReloadSubHSM.o ${OBJECTDIR}/_ext/554456555/motors.o ${OBJECTDIR}/TapeFollowSM.o ${OBJECTDIR}/BumperService.o ${OBJECTDIR}/BumpResService.o ${OBJECTDIR}/ReceiveService.o ${OBJECTDIR}/ScoreSubHSM.o ${OBJECTDIR}/TrackWireService.o ${OBJECTDIR}/InitSubHSM.o ${OBJECTDIR}/DepositBallsSM.o ${OBJECTDIR}/ExclusionRadar.o ${OBJECTDIR}/BatteryAdjust.o
+OBJECTFILES=${OBJECTDIR}/_ext/331920610/AD.o ${OBJECTDIR}/_ext/331920610/BOARD.o ${OBJECTDIR}/_ext/331920610/IO_Ports.o ${OBJECTDIR}/_ext/331920610/LED.o ${OBJECTDIR}/_ext/331920610/RC_Servo.o ${OBJECTDIR}/_ext/331920610/pwm.o ${OBJECTDIR}/_ext/331920610/serial.o ${OBJECTDIR}/_ext/331920610/timers.o ${OBJECTDIR}/_ext/331920610/ES_CheckEvents.o ${OBJECTDIR}/_ext/331920610/ES_Framework.o ${OBJECTDIR}/_ext/331920610/ES_KeyboardInput.o ${OBJECTDIR}/_ext/331920610/ES_PostList.o ${OBJECTDIR}/_ext/331920610/ES_Queue.o ${OBJECTDIR}/_ext/331920610/ES_TattleTale.o ${OBJECTDIR}/_ext/331920610/ES_Timers.o ${OBJECTDIR}/TapeSensorService.o ${OBJECTDIR}/main.o ${OBJECTDIR}/EventChecker.o ${OBJECTDIR}/BaseFSM.o ${OBJECTDIR}/TemplateService.o ${OBJECTDIR}/TemplateSubHSM.o ${OBJECTDIR}/TopHSM.o ${OBJECTDIR}/ReloadSubHSM.o ${OBJECTDIR}/_ext/554456555/motors.o ${OBJECTDIR}/TapeFollowSM.o ${OBJECTDIR}/BumperService.o ${OBJECTDIR}/BumpResService.o ${OBJECTDIR}/ReceiveService.o ${OBJECTDIR}/ScoreSubHSM.o ${OBJECTDIR}/TrackWireService.o ${OBJECTDIR}/InitSubHSM.o ${OBJECTDIR}/DepositBallsSM.o ${OBJECTDIR}/ExclusionRadar.o ${OBJECTDIR}/BatteryAdjust.o ${OBJECTDIR}/ES_Names.o ${OBJECTDIR}/EventPool.o ${OBJECTDIR}/FlashStore.o ${OBJECTDIR}/TapeFrame.o ${OBJECTDIR}/WorldState.o ${OBJECTDIR}/StateStats.o ${OBJECTDIR}/HSMHistory.o ${OBJECTDIR}/HSMDefer.o ${OBJECTDIR}/ADFrame.o ${OBJECTDIR}/SensorRate.o ${OBJECTDIR}/CycleBench.o ${OBJECTDIR}/HIL.o ${OBJECTDIR}/EventMailbox.o ${OBJECTDIR}/EventLanes.o ${OBJECTDIR}/ServiceHost.o ${OBJECTDIR}/ES_Hosted.o ${OBJECTDIR}/Idle.o ${OBJECTDIR}/SerialTx.o ${OBJECTDIR}/SensorTier.o ${OBJECTDIR}/WheelCalService.o ${OBJECTDIR}/HSMSupervisor.o ${OBJECTDIR}/BootProfile.o
 
 # Source Files
-SOURCEFILES=C:/CMPE118/src/AD.c C:/CMPE118/src/BOARD.c C:/CMPE118/src/IO_Ports.c C:/CMPE118/src/LED.c C:/CMPE118/src/RC_Servo.c C:/CMPE118/src/pwm.c C:/CMPE118/src/serial.c C:/CMPE118/src/timers.c C:/CMPE118/src/ES_CheckEvents.c C:/CMPE118/src/ES_Framework.c C:/CMPE118/src/ES_KeyboardInput.c C:/CMPE118/src/ES_PostList.c C:/CMPE118/src/ES_Queue.c C:/CMPE118/src/ES_TattleTale.c C:/CMPE118/src/ES_Timers.c TapeSensorService.c main.c EventChecker.c BaseFSM.c TemplateService.c TemplateSubHSM.c TopHSM.c ReloadSubHSM.c ../Motor_test/motors.c TapeFollowSM.c BumperService.c BumpResService.c ReceiveService.c ScoreSubHSM.c TrackWireService.c InitSubHSM.c DepositBallsSM.c ExclusionRadar.c BatteryAdjust.c
+SOURCEFILES=C:/CMPE118/src/AD.c C:/CMPE118/src/BOARD.c C:/CMPE118/src/IO_Ports.c C:/CMPE118/src/LED.c C:/CMPE118/src/RC_Servo.c C:/CMPE118/src/pwm.c C:/CMPE118/src/serial.c C:/CMPE118/src/timers.c C:/CMPE118/src/ES_CheckEvents.c C:/CMPE118/src/ES_Framework.c C:/CMPE118/src/ES_KeyboardInput.c C:/CMPE118/src/ES_PostList.c C:/CMPE118/src/ES_Queue.c C:/CMPE118/src/ES_TattleTale.c C:/CMPE118/src/ES_Timers.c TapeSensorService.c main.c EventChecker.c BaseFSM.c TemplateService.c TemplateSubHSM.c TopHSM.c ReloadSubHSM.c ../Motor_test/motors.c TapeFollowSM.c BumperService.c BumpResService.c ReceiveService.c ScoreSubHSM.c TrackWireService.c InitSubHSM.c DepositBallsSM.c ExclusionRadar.c BatteryAdjust.c ES_Names.c EventPool.c FlashStore.c TapeFrame.c WorldState.c StateStats.c HSMHistory.c HSMDefer.c ADFrame.c SensorRate.c CycleBench.c HIL.c EventMailbox.c EventLanes.c ServiceHost.c ES_Hosted.c Idle.c SerialTx.c SensorTier.c WheelCalService.c HSMSupervisor.c BootProfile.c
 
 
 CFLAGS=
@@ -317,6 +317,138 @@ ${OBJECTDIR}/BatteryAdjust.o: BatteryAdjust.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/BatteryAdjust.o 
 	@${FIXDEPS} "${OBJECTDIR}/BatteryAdjust.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/BatteryAdjust.o.d" -o ${OBJECTDIR}/BatteryAdjust.o BatteryAdjust.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
 	
+${OBJECTDIR}/ES_Names.o: ES_Names.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ES_Names.o.d 
+	@${RM} ${OBJECTDIR}/ES_Names.o 
+	@${FIXDEPS} "${OBJECTDIR}/ES_Names.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ES_Names.o.d" -o ${OBJECTDIR}/ES_Names.o ES_Names.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/EventPool.o: EventPool.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventPool.o.d 
+	@${RM} ${OBJECTDIR}/EventPool.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventPool.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/EventPool.o.d" -o ${OBJECTDIR}/EventPool.o EventPool.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/FlashStore.o: FlashStore.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/FlashStore.o.d 
+	@${RM} ${OBJECTDIR}/FlashStore.o 
+	@${FIXDEPS} "${OBJECTDIR}/FlashStore.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/FlashStore.o.d" -o ${OBJECTDIR}/FlashStore.o FlashStore.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/TapeFrame.o: TapeFrame.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/TapeFrame.o.d 
+	@${RM} ${OBJECTDIR}/TapeFrame.o 
+	@${FIXDEPS} "${OBJECTDIR}/TapeFrame.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/TapeFrame.o.d" -o ${OBJECTDIR}/TapeFrame.o TapeFrame.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/WorldState.o: WorldState.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/WorldState.o.d 
+	@${RM} ${OBJECTDIR}/WorldState.o 
+	@${FIXDEPS} "${OBJECTDIR}/WorldState.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/WorldState.o.d" -o ${OBJECTDIR}/WorldState.o WorldState.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/StateStats.o: StateStats.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/StateStats.o.d 
+	@${RM} ${OBJECTDIR}/StateStats.o 
+	@${FIXDEPS} "${OBJECTDIR}/StateStats.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/StateStats.o.d" -o ${OBJECTDIR}/StateStats.o StateStats.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HSMHistory.o: HSMHistory.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HSMHistory.o.d 
+	@${RM} ${OBJECTDIR}/HSMHistory.o 
+	@${FIXDEPS} "${OBJECTDIR}/HSMHistory.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HSMHistory.o.d" -o ${OBJECTDIR}/HSMHistory.o HSMHistory.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HSMDefer.o: HSMDefer.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HSMDefer.o.d 
+	@${RM} ${OBJECTDIR}/HSMDefer.o 
+	@${FIXDEPS} "${OBJECTDIR}/HSMDefer.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HSMDefer.o.d" -o ${OBJECTDIR}/HSMDefer.o HSMDefer.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/ADFrame.o: ADFrame.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ADFrame.o.d 
+	@${RM} ${OBJECTDIR}/ADFrame.o 
+	@${FIXDEPS} "${OBJECTDIR}/ADFrame.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ADFrame.o.d" -o ${OBJECTDIR}/ADFrame.o ADFrame.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/SensorRate.o: SensorRate.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SensorRate.o.d 
+	@${RM} ${OBJECTDIR}/SensorRate.o 
+	@${FIXDEPS} "${OBJECTDIR}/SensorRate.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/SensorRate.o.d" -o ${OBJECTDIR}/SensorRate.o SensorRate.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/CycleBench.o: CycleBench.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/CycleBench.o.d 
+	@${RM} ${OBJECTDIR}/CycleBench.o 
+	@${FIXDEPS} "${OBJECTDIR}/CycleBench.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/CycleBench.o.d" -o ${OBJECTDIR}/CycleBench.o CycleBench.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HIL.o: HIL.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HIL.o.d 
+	@${RM} ${OBJECTDIR}/HIL.o 
+	@${FIXDEPS} "${OBJECTDIR}/HIL.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HIL.o.d" -o ${OBJECTDIR}/HIL.o HIL.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/EventMailbox.o: EventMailbox.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventMailbox.o.d 
+	@${RM} ${OBJECTDIR}/EventMailbox.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventMailbox.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/EventMailbox.o.d" -o ${OBJECTDIR}/EventMailbox.o EventMailbox.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/EventLanes.o: EventLanes.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventLanes.o.d 
+	@${RM} ${OBJECTDIR}/EventLanes.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventLanes.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/EventLanes.o.d" -o ${OBJECTDIR}/EventLanes.o EventLanes.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/ServiceHost.o: ServiceHost.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ServiceHost.o.d 
+	@${RM} ${OBJECTDIR}/ServiceHost.o 
+	@${FIXDEPS} "${OBJECTDIR}/ServiceHost.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ServiceHost.o.d" -o ${OBJECTDIR}/ServiceHost.o ServiceHost.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/ES_Hosted.o: ES_Hosted.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ES_Hosted.o.d 
+	@${RM} ${OBJECTDIR}/ES_Hosted.o 
+	@${FIXDEPS} "${OBJECTDIR}/ES_Hosted.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ES_Hosted.o.d" -o ${OBJECTDIR}/ES_Hosted.o ES_Hosted.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/Idle.o: Idle.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Idle.o.d 
+	@${RM} ${OBJECTDIR}/Idle.o 
+	@${FIXDEPS} "${OBJECTDIR}/Idle.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/Idle.o.d" -o ${OBJECTDIR}/Idle.o Idle.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/SerialTx.o: SerialTx.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SerialTx.o.d 
+	@${RM} ${OBJECTDIR}/SerialTx.o 
+	@${FIXDEPS} "${OBJECTDIR}/SerialTx.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/SerialTx.o.d" -o ${OBJECTDIR}/SerialTx.o SerialTx.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/SensorTier.o: SensorTier.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SensorTier.o.d 
+	@${RM} ${OBJECTDIR}/SensorTier.o 
+	@${FIXDEPS} "${OBJECTDIR}/SensorTier.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/SensorTier.o.d" -o ${OBJECTDIR}/SensorTier.o SensorTier.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/WheelCalService.o: WheelCalService.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/WheelCalService.o.d 
+	@${RM} ${OBJECTDIR}/WheelCalService.o 
+	@${FIXDEPS} "${OBJECTDIR}/WheelCalService.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/WheelCalService.o.d" -o ${OBJECTDIR}/WheelCalService.o WheelCalService.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HSMSupervisor.o: HSMSupervisor.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HSMSupervisor.o.d 
+	@${RM} ${OBJECTDIR}/HSMSupervisor.o 
+	@${FIXDEPS} "${OBJECTDIR}/HSMSupervisor.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HSMSupervisor.o.d" -o ${OBJECTDIR}/HSMSupervisor.o HSMSupervisor.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/BootProfileootProfile.o: BootProfile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/BootProfileootProfile.o.d 
+	@${RM} ${OBJECTDIR}/BootProfileootProfile.o 
+	@${FIXDEPS} "${OBJECTDIR}/BootProfileootProfile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_SIMULATOR=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/BootProfileootProfile.o.d" -o ${OBJECTDIR}/BootProfileootProfile.o BootProfile.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
 else
 ${OBJECTDIR}/_ext/331920610/AD.o: C:/CMPE118/src/AD.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/331920610" 
@@ -522,6 +654,138 @@ ${OBJECTDIR}/BatteryAdjust.o: BatteryAdjust.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/BatteryAdjust.o 
 	@${FIXDEPS} "${OBJECTDIR}/BatteryAdjust.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/BatteryAdjust.o.d" -o ${OBJECTDIR}/BatteryAdjust.o BatteryAdjust.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
 	
+${OBJECTDIR}/ES_Names.o: ES_Names.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ES_Names.o.d 
+	@${RM} ${OBJECTDIR}/ES_Names.o 
+	@${FIXDEPS} "${OBJECTDIR}/ES_Names.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ES_Names.o.d" -o ${OBJECTDIR}/ES_Names.o ES_Names.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/EventPool.o: EventPool.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventPool.o.d 
+	@${RM} ${OBJECTDIR}/EventPool.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventPool.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/EventPool.o.d" -o ${OBJECTDIR}/EventPool.o EventPool.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/FlashStore.o: FlashStore.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/FlashStore.o.d 
+	@${RM} ${OBJECTDIR}/FlashStore.o 
+	@${FIXDEPS} "${OBJECTDIR}/FlashStore.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/FlashStore.o.d" -o ${OBJECTDIR}/FlashStore.o FlashStore.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/TapeFrame.o: TapeFrame.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/TapeFrame.o.d 
+	@${RM} ${OBJECTDIR}/TapeFrame.o 
+	@${FIXDEPS} "${OBJECTDIR}/TapeFrame.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/TapeFrame.o.d" -o ${OBJECTDIR}/TapeFrame.o TapeFrame.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/WorldState.o: WorldState.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/WorldState.o.d 
+	@${RM} ${OBJECTDIR}/WorldState.o 
+	@${FIXDEPS} "${OBJECTDIR}/WorldState.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/WorldState.o.d" -o ${OBJECTDIR}/WorldState.o WorldState.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/StateStats.o: StateStats.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/StateStats.o.d 
+	@${RM} ${OBJECTDIR}/StateStats.o 
+	@${FIXDEPS} "${OBJECTDIR}/StateStats.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/StateStats.o.d" -o ${OBJECTDIR}/StateStats.o StateStats.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HSMHistory.o: HSMHistory.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HSMHistory.o.d 
+	@${RM} ${OBJECTDIR}/HSMHistory.o 
+	@${FIXDEPS} "${OBJECTDIR}/HSMHistory.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HSMHistory.o.d" -o ${OBJECTDIR}/HSMHistory.o HSMHistory.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HSMDefer.o: HSMDefer.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HSMDefer.o.d 
+	@${RM} ${OBJECTDIR}/HSMDefer.o 
+	@${FIXDEPS} "${OBJECTDIR}/HSMDefer.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HSMDefer.o.d" -o ${OBJECTDIR}/HSMDefer.o HSMDefer.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/ADFrame.o: ADFrame.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ADFrame.o.d 
+	@${RM} ${OBJECTDIR}/ADFrame.o 
+	@${FIXDEPS} "${OBJECTDIR}/ADFrame.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ADFrame.o.d" -o ${OBJECTDIR}/ADFrame.o ADFrame.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/SensorRate.o: SensorRate.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SensorRate.o.d 
+	@${RM} ${OBJECTDIR}/SensorRate.o 
+	@${FIXDEPS} "${OBJECTDIR}/SensorRate.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/SensorRate.o.d" -o ${OBJECTDIR}/SensorRate.o SensorRate.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/CycleBench.o: CycleBench.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/CycleBench.o.d 
+	@${RM} ${OBJECTDIR}/CycleBench.o 
+	@${FIXDEPS} "${OBJECTDIR}/CycleBench.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/CycleBench.o.d" -o ${OBJECTDIR}/CycleBench.o CycleBench.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HIL.o: HIL.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HIL.o.d 
+	@${RM} ${OBJECTDIR}/HIL.o 
+	@${FIXDEPS} "${OBJECTDIR}/HIL.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HIL.o.d" -o ${OBJECTDIR}/HIL.o HIL.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/EventMailbox.o: EventMailbox.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventMailbox.o.d 
+	@${RM} ${OBJECTDIR}/EventMailbox.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventMailbox.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/EventMailbox.o.d" -o ${OBJECTDIR}/EventMailbox.o EventMailbox.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/EventLanes.o: EventLanes.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventLanes.o.d 
+	@${RM} ${OBJECTDIR}/EventLanes.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventLanes.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/EventLanes.o.d" -o ${OBJECTDIR}/EventLanes.o EventLanes.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/ServiceHost.o: ServiceHost.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ServiceHost.o.d 
+	@${RM} ${OBJECTDIR}/ServiceHost.o 
+	@${FIXDEPS} "${OBJECTDIR}/ServiceHost.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ServiceHost.o.d" -o ${OBJECTDIR}/ServiceHost.o ServiceHost.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/ES_Hosted.o: ES_Hosted.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ES_Hosted.o.d 
+	@${RM} ${OBJECTDIR}/ES_Hosted.o 
+	@${FIXDEPS} "${OBJECTDIR}/ES_Hosted.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/ES_Hosted.o.d" -o ${OBJECTDIR}/ES_Hosted.o ES_Hosted.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/Idle.o: Idle.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Idle.o.d 
+	@${RM} ${OBJECTDIR}/Idle.o 
+	@${FIXDEPS} "${OBJECTDIR}/Idle.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/Idle.o.d" -o ${OBJECTDIR}/Idle.o Idle.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/SerialTx.o: SerialTx.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SerialTx.o.d 
+	@${RM} ${OBJECTDIR}/SerialTx.o 
+	@${FIXDEPS} "${OBJECTDIR}/SerialTx.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/SerialTx.o.d" -o ${OBJECTDIR}/SerialTx.o SerialTx.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/SensorTier.o: SensorTier.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SensorTier.o.d 
+	@${RM} ${OBJECTDIR}/SensorTier.o 
+	@${FIXDEPS} "${OBJECTDIR}/SensorTier.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/SensorTier.o.d" -o ${OBJECTDIR}/SensorTier.o SensorTier.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/WheelCalService.o: WheelCalService.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/WheelCalService.o.d 
+	@${RM} ${OBJECTDIR}/WheelCalService.o 
+	@${FIXDEPS} "${OBJECTDIR}/WheelCalService.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/WheelCalService.o.d" -o ${OBJECTDIR}/WheelCalService.o WheelCalService.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/HSMSupervisor.o: HSMSupervisor.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/HSMSupervisor.o.d 
+	@${RM} ${OBJECTDIR}/HSMSupervisor.o 
+	@${FIXDEPS} "${OBJECTDIR}/HSMSupervisor.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/HSMSupervisor.o.d" -o ${OBJECTDIR}/HSMSupervisor.o HSMSupervisor.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/BootProfileootProfile.o: BootProfile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/BootProfileootProfile.o.d 
+	@${RM} ${OBJECTDIR}/BootProfileootProfile.o 
+	@${FIXDEPS} "${OBJECTDIR}/BootProfileootProfile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -DSIMPLESERVICE_TEST -I"." -I"C:/CMPE118/include" -I"C:/CMPE118" -MMD -MF "${OBJECTDIR}/BootProfileootProfile.o.d" -o ${OBJECTDIR}/BootProfileootProfile.o BootProfile.c    -DXPRJ_default=$(CND_CONF)  -no-legacy-libc  $(COMPARISON_BUILD) 
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -546,8 +810,8 @@ endif
 
 .pre:
 	@echo "--------------------------------------"
-	@echo "User defined pre-build step: [python C:\CMPE118\scripts\Enum_To_String.py]"
-	@python C:\CMPE118\scripts\Enum_To_String.py
+	@echo "User defined pre-build step: [python ES_Gen.py]"
+	@python ES_Gen.py
 	@echo "--------------------------------------"
 
 # Subprojects